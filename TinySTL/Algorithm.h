@@ -628,29 +628,49 @@ namespace TinySTL
 	template<class ForwardIterator, class T>
 	ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& val)
 	{
-		if (first == last)  return first;
-		int len = last - first;
-		int half = 0;
-		ForwardIterator mid = first;
+		typename iterator_traits<ForwardIterator>::difference_type len = last - first;
+		typename iterator_traits<ForwardIterator>::difference_type half = 0;
+		ForwardIterator mid;
 		while (len > 0)
 		{
 			half = len >> 1;  //  half = len / 2;
-			mid = first;
 			mid = first + half;
 			if (*mid < val)
 			{
 				first = mid;
 				++first;
-				half = len - half - 1;
+				len = len - half - 1;
 			}
 			else
 			{
 				len = half;
 			}
-			return first;
 		}
-
-
+		return first;
+	}
+	// compoperator <бǰcompź
+	template<class ForwardIterator, class T, class Compare>
+	ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& val, Compare comp)
+	{
+		typename iterator_traits<ForwardIterator>::difference_type len = last - first;
+		typename iterator_traits<ForwardIterator>::difference_type half = 0;
+		ForwardIterator mid;
+		while (len > 0)
+		{
+			half = len >> 1;
+			mid = first + half;
+			if (comp(*mid, val))
+			{
+				first = mid;
+				++first;
+				len = len - half - 1;
+			}
+			else
+			{
+				len = half;
+			}
+		}
+		return first;
 	}
 
 	/********************[ upper_bound ]***********************************/
@@ -685,6 +705,29 @@ namespace TinySTL
 		return first;
 
 	}
+	template<class ForwardIterator, class T, class Compare>
+	ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& val, Compare comp)
+	{
+		typename iterator_traits<ForwardIterator>::difference_type len = last - first;
+		typename iterator_traits<ForwardIterator>::difference_type half = 0;
+		ForwardIterator mid;
+		while (len > 0)
+		{
+			half = len >> 1;
+			mid = first + half;
+			if (comp(val, *mid))
+			{
+				len = half;
+			}
+			else
+			{
+				first = mid;
+				++first;
+				len = len - half - 1;
+			}
+		}
+		return first;
+	}
 
 	/********************[ binary_search ]***********************************/
 	/********************[Algorithm Time Complexity: O(logN)]************/
@@ -693,6 +736,7 @@ namespace TinySTL
 	bool binary_search(ForwardIterator first, ForwardIterator last, const T& val)
 	{
 		if (first == last) return false;
+		ForwardIterator mid;
 		while (first != last)
 		{
 			mid = first + (last - first) / 2;
@@ -712,6 +756,12 @@ namespace TinySTL
 		}
 		return false;
 	}
+	template<class ForwardIterator, class T, class Compare>
+	bool binary_search(ForwardIterator first, ForwardIterator last, const T& val, Compare comp)
+	{
+		first = TinySTL::lower_bound(first, last, val, comp);
+		return first != last && !comp(val, *first);
+	}
 
 	/********************[ random_shuffle ]***********************************/
 	/********************[Algorithm Time Complexity: O(N)]************/
@@ -739,9 +789,12 @@ namespace TinySTL
 
 		for (RandomIterator iter = first + 1; iter != last; ++iter)
 		{
-			iterator_traits<RandomIterator>::value_type value = *iter;
+			typename iterator_traits<RandomIterator>::value_type value = *iter;
 			if (value < *first)
+			{
 				copy_backward(first, iter, iter + 1);
+				*first = value;
+			}
 			else
 			{       // ˵value һ *first СҲһԽ
 				RandomIterator next = iter;
@@ -830,6 +883,86 @@ namespace TinySTL
 			_quick_sort(first, last);
 	}
 
+	/*****************************[ sort with Compare ]**************************************/
+	// compoperator <İ汾ͬ
+	template<class RandomIterator, class Compare>
+	void _insert_sort(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		if (first == last) return;
+
+		for (RandomIterator iter = first + 1; iter != last; ++iter)
+		{
+			typename iterator_traits<RandomIterator>::value_type value = *iter;
+			if (comp(value, *first))
+			{
+				copy_backward(first, iter, iter + 1);
+				*first = value;
+			}
+			else
+			{
+				RandomIterator next = iter;
+				--next;
+				while (comp(value, *next))
+				{
+					*(next + 1) = *next;
+					--next;
+				}
+				*(next + 1) = value;
+			}
+		}
+	}
+	template<class T, class Compare>
+	inline const T& _median(const T& a, const T& b, const T& c, Compare comp)
+	{
+		if (comp(a, b))
+			return comp(b, c) ? b : (comp(c, a) ? a : c);
+		else
+			return comp(c, b) ? b : (comp(a, c) ? a : c);
+	}
+	template<class RandomIterator, class T, class Compare>
+	RandomIterator _partial_quick_sort(RandomIterator first, RandomIterator last, T pivot, Compare comp)
+	{
+		while (first < last)
+		{
+			while (comp(*first, pivot))
+				++first;
+			--last;
+			while (comp(pivot, *last))
+				--last;
+			if (first < last)
+				TinySTL::iter_swap(first, last);
+			else
+				return first;
+			++first;
+		}
+		return first;
+	}
+	template<class RandomIterator, class Compare>
+	void _quick_sort(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		while (last - first >= 16)     // ϶̵һߵݹ飬ϳһѭݹȲlogN
+		{
+			RandomIterator cut = _partial_quick_sort(first, last, _median(*first, *(last - 1), *(first + (last - first) / 2), comp), comp);
+			if (cut - first < last - cut)
+			{
+				_quick_sort(first, cut, comp);
+				first = cut;
+			}
+			else
+			{
+				_quick_sort(cut, last, comp);
+				last = cut;
+			}
+		}
+		_insert_sort(first, last, comp);
+	}
+	template<class RandomIterator, class Compare>
+	inline void sort(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		if (first == last) return;
+		_quick_sort(first, last, comp);
+	}
+
 
 	/************************************************************* sort ************************************************************************/
 
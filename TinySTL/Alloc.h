@@ -13,7 +13,7 @@ namespace TinySTL {
 /*
 *     次级空间配置器，仅用于给Allocator提供部分接口 
 *     内部使用 
-*     
+*     freelist和内存池为所有线程共享，由Alloc.cpp中的一把自旋锁保护，可以在多个线程中同时分配、回收
 */
 	class alloc {
 	private:
@@ -0,0 +1,104 @@
+#ifndef _ASCII_H_
+#define _ASCII_H_
+
+/*
+*	Author  @yyehl
+*/
+
+#include "String.h"
+#include "String_view.h"
+#include "Functional.h"
+#include "./Detail/hash_functions.h"
+#include "./Detail/simd_functions.h"
+
+/*
+*  ASCII 字符串的大小写转换与不区分大小写的比较，适合HTTP头部名称这类只含ASCII的字符串
+*  只有'A'-'Z'、'a'-'z'参与大小写转换，不依赖locale，非ASCII字节按原样比较
+*  内部用SSE2/AVX2每次处理16/32个字节（见 Detail/simd_functions.h）
+*
+*  ascii_ihash、ascii_iequal_to 可以作为hashtable（hash_map、hash_set）的Hashfcn和Equalkey，
+*  ascii_iless 可以作为rb_tree（map、set）的Compare，实现不区分大小写的容器
+*/
+
+namespace TinySTL
+{
+	/********************** 大小写转换 ******************************/
+	inline void ascii_to_lower(char* first, char* last) { simd_ascii_case(first, first, last, false); }
+	inline void ascii_to_upper(char* first, char* last) { simd_ascii_case(first, first, last, true); }
+
+	inline string& ascii_to_lower(string& str) { ascii_to_lower(str.begin(), str.end()); return str; }
+	inline string& ascii_to_upper(string& str) { ascii_to_upper(str.begin(), str.end()); return str; }
+
+	inline string ascii_to_lower_copy(const string_view& sv)
+	{
+		string ret(sv.begin(), sv.end());
+		ascii_to_lower(ret.begin(), ret.end());
+		return ret;
+	}
+	inline string ascii_to_upper_copy(const string_view& sv)
+	{
+		string ret(sv.begin(), sv.end());
+		ascii_to_upper(ret.begin(), ret.end());
+		return ret;
+	}
+
+	/********************** 不区分大小写的比较 ******************************/
+	inline bool ascii_iequals(const string_view& lhs, const string_view& rhs)
+	{
+		return lhs.size() == rhs.size() && simd_ascii_mismatch_nocase(lhs.data(), rhs.data(), lhs.size()) == lhs.size();
+	}
+
+	// 按转换成小写之后的字典序比较，小于返回负数，相等返回0，大于返回正数
+	inline int ascii_icompare(const string_view& lhs, const string_view& rhs)
+	{
+		size_t len = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+		size_t pos = simd_ascii_mismatch_nocase(lhs.data(), rhs.data(), len);
+		if (pos != len)
+		{
+			unsigned char a = static_cast<unsigned char>(ascii_lower_char(lhs[pos]));
+			unsigned char b = static_cast<unsigned char>(ascii_lower_char(rhs[pos]));
+			return a < b ? -1 : 1;
+		}
+		return (lhs.size() < rhs.size()) ? -1 : (lhs.size() == rhs.size() ? 0 : 1);
+	}
+
+	// 转换成小写之后再求hash，大小写不同的字符串得到相同的hash值
+	inline size_t ascii_ihash_bytes(const char* s, size_t n)
+	{
+		char buf[256];
+		if (n <= sizeof(buf))
+		{
+			simd_ascii_case(buf, s, s + n, false);
+			return hash_fcn_string(buf, n);
+		}
+		size_t h = n;
+		for (const char* last = s + n; s != last; )   // 长字符串分块转换，每块的hash再合并起来
+		{
+			size_t len = (last - s) < static_cast<ptrdiff_t>(sizeof(buf)) ? static_cast<size_t>(last - s) : sizeof(buf);
+			simd_ascii_case(buf, s, s + len, false);
+			h ^= hash_fcn_string(buf, len) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			s += len;
+		}
+		return h;
+	}
+
+	/********************** 供容器使用的仿函数 ******************************/
+	struct ascii_ihash
+	{
+		size_t operator () (const string_view& sv) const { return ascii_ihash_bytes(sv.data(), sv.size()); }
+	};
+
+	struct ascii_iequal_to : public binary_function<string_view, string_view, bool>
+	{
+		bool operator () (const string_view& x, const string_view& y) const { return ascii_iequals(x, y); }
+	};
+
+	struct ascii_iless : public binary_function<string_view, string_view, bool>
+	{
+		bool operator () (const string_view& x, const string_view& y) const { return ascii_icompare(x, y) < 0; }
+	};
+
+}  // namespace TinySTL
+
+
+#endif // !_ASCII_H_
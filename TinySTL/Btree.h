@@ -0,0 +1,269 @@
+#ifndef _BTREE_H_
+#define _BTREE_H_
+
+/*
+*   Author   @yyehl
+*/
+
+#include "Functional.h"
+#include "Allocator.h"
+#include "Construct.h"
+#include "Utility.h"
+#include "Iterator.h"
+
+#include <type_traits>
+#include <utility>
+
+/*
+*  btree 是B树，与rb_tree并列，作为btree_map、btree_set、btree_multimap、btree_multiset的底层
+*
+*  rb_tree每个节点只放一个元素，另外还有三个指针和一个颜色，查找时每下降一层都是一次不相关的cache miss，
+*  遍历时也要在分散的节点之间跳来跳去
+*  btree的每个节点是一块连续的内存，里面按顺序放着多个元素，大小由模板参数NodeBytes决定（默认256字节，4个cache line）：
+*      叶节点      ：parent、position（自己在父节点中的下标）、count、leaf + 至多capacity个元素
+*      内部节点    ：叶节点的全部内容 + capacity + 1个子节点指针，children[i]中的元素都在values[i - 1]与values[i]之间
+*  节点内用二分查找，树高大约是log(n) / log(capacity)，查找时访问的cache line少得多，遍历时大部分时间在同一个节点内顺序前进
+*  以int为元素时每个节点放60个，平均每个元素的额外开销不到一个指针（rb_tree为三个指针加一个颜色）
+*
+*  插入：元素总是插入到叶节点，叶节点满了就从中间分裂，中间的元素上移到父节点（父节点满了先分裂父节点）
+*  删除：内部节点中的元素先与前驱（左子树中最大的元素，一定在叶节点）交换，再从叶节点中删除；
+*       节点的元素个数少于min_count时，先向兄弟节点借一个，借不到就与兄弟节点合并
+*  除根节点外，每个节点至少有min_count = (capacity - 1) / 2个元素
+*
+*  迭代器由（节点，下标）组成，end()为（最右的叶节点，count）
+*  注意：与rb_tree不同，插入、删除会在节点之间移动元素，所有的迭代器、指针、引用都会失效
+*/
+
+namespace TinySTL
+{
+	/*********************** struct btree_node *****************************/
+	template<class Value, size_t NodeBytes>
+	struct btree_node
+	{
+		typedef btree_node<Value, NodeBytes>  node;
+
+		static const size_t header_bytes = sizeof(void*) + 8;     // parent指针 + position、count、leaf
+		static const size_t fit_count = (NodeBytes > header_bytes ? NodeBytes - header_bytes : 0) / sizeof(Value);
+		static const size_t capacity = fit_count < 3 ? 3 : fit_count;        // 每个节点最多放的元素个数，至少3个
+		static const size_t min_count = (capacity - 1) / 2;                  // 非根节点最少的元素个数
+
+		node* parent;               // 根节点的parent为nullptr
+		unsigned short position;    // 自己在父节点children中的下标
+		unsigned short count;       // 元素个数
+		bool leaf;
+		alignas(Value) unsigned char storage[capacity * sizeof(Value)];   // 元素的原始内存，用construct、destroy管理
+
+		Value& value(size_t i) { return reinterpret_cast<Value*>(storage)[i]; }
+		Value* value_ptr(size_t i) { return reinterpret_cast<Value*>(storage) + i; }
+		node*& child(size_t i);     // 只能对内部节点调用
+	};
+
+	template<class Value, size_t NodeBytes>
+	struct btree_internal_node : public btree_node<Value, NodeBytes>
+	{
+		btree_node<Value, NodeBytes>* children[btree_node<Value, NodeBytes>::capacity + 1];
+	};
+
+	template<class Value, size_t NodeBytes>
+	inline btree_node<Value, NodeBytes>*& btree_node<Value, NodeBytes>::child(size_t i)
+	{
+		return static_cast<btree_internal_node<Value, NodeBytes>*>(this)->children[i];
+	}
+
+	/*********************** struct btree_iterator *****************************/
+	template<class Value, class Ref, class Ptr, size_t NodeBytes>
+	struct btree_iterator
+	{
+		typedef btree_iterator<Value, Value&, Value*, NodeBytes>              iterator;
+		typedef btree_iterator<Value, const Value&, const Value*, NodeBytes>  const_iterator;
+		typedef btree_iterator<Value, Ref, Ptr, NodeBytes>                    self;
+		typedef btree_node<Value, NodeBytes>                                  node;
+
+		typedef bidirectional_iterator_tag  iterator_category;
+		typedef Value                       value_type;
+		typedef ptrdiff_t                   difference_type;
+		typedef size_t                      size_type;
+		typedef Ref                         reference;
+		typedef Ptr                         pointer;
+
+		/* 数据结构 */
+		node* nd;        // 所在的节点
+		size_type pos;   // 在节点中的下标
+
+		btree_iterator() : nd(nullptr), pos(0) { }
+		btree_iterator(node* x, size_type i) : nd(x), pos(i) { }
+		btree_iterator(const self& x) = default;
+		// iterator转换为const_iterator；写成模板，不与上面的复制构造函数冲突（self为iterator时两者参数相同）
+		template<class R, class P, class = typename std::enable_if<std::is_same<btree_iterator<Value, R, P, NodeBytes>, iterator>::value>::type>
+		btree_iterator(const btree_iterator<Value, R, P, NodeBytes>& x) : nd(x.nd), pos(x.pos) { }
+		self& operator = (const self& x) = default;
+
+		reference operator * () const { return nd->value(pos); }
+		pointer operator -> () const { return &(operator*()); }
+
+		self& operator ++ () { increase(); return *this; }
+		self operator ++ (int) { self tmp = *this; increase(); return tmp; }
+		self& operator -- () { decrease(); return *this; }
+		self operator -- (int) { self tmp = *this; decrease(); return tmp; }
+
+		bool operator == (const self& x) const { return nd == x.nd && pos == x.pos; }
+		bool operator != (const self& x) const { return !(*this == x); }
+
+		void increase();
+		void decrease();
+	};
+
+	/************************* class btree **************************************/
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes = 256>
+	class btree
+	{
+		/*
+		*  模板参数与rb_tree相同
+		*  Key：键值类型    Value：元素类型    KeyOfValue：从元素中取出key的方法    Compare：key的比较方法
+		*  NodeBytes：每个节点大约占用的字节数，决定了每个节点放多少个元素
+		*  节点的大小与元素的类型有关，叶节点与内部节点的大小也不同，所以不像rb_tree那样接受一个节点的空间配置器，
+		*  直接使用allocator<叶节点>和allocator<内部节点>
+		*/
+
+	public:
+		typedef Key                key_type;
+		typedef Value              value_type;
+		typedef Compare            key_compare;
+		typedef value_type*        pointer;
+		typedef const value_type*  const_pointer;
+		typedef value_type&        reference;
+		typedef const value_type&  const_reference;
+		typedef size_t             size_type;
+		typedef ptrdiff_t          difference_type;
+		typedef btree_iterator<Value, Value&, Value*, NodeBytes>              iterator;
+		typedef btree_iterator<Value, const Value&, const Value*, NodeBytes>  const_iterator;
+
+	private:
+		typedef btree_node<Value, NodeBytes>           node;
+		typedef btree_internal_node<Value, NodeBytes>  internal_node;
+		typedef allocator<node>                        leaf_allocator;
+		typedef allocator<internal_node>               internal_allocator;
+		typedef btree<Key, Value, KeyOfValue, Compare, NodeBytes>  self;
+
+		static const size_type capacity = node::capacity;
+		static const size_type min_count = node::min_count;
+
+		// 以下是btree的数据结构
+		node* root;          // 空树时为nullptr
+		node* leftmost;      // 最左的叶节点，begin()
+		node* rightmost;     // 最右的叶节点，end()
+		size_type node_count;
+		key_compare comp;
+		KeyOfValue get_key;
+
+	public:
+		explicit btree(const Compare& cmp = Compare())
+			: root(nullptr), leftmost(nullptr), rightmost(nullptr), node_count(0), comp(cmp), get_key(KeyOfValue()) { }
+		btree(const self& x);
+		~btree() { clear(); }
+
+		self& operator = (const self& x);
+
+		key_compare key_comp() const { return comp; }
+		iterator begin() { return iterator(leftmost, 0); }
+		iterator end() { return iterator(rightmost, rightmost == nullptr ? 0 : rightmost->count); }
+		const_iterator begin() const { return const_cast<self*>(this)->begin(); }
+		const_iterator end() const { return const_cast<self*>(this)->end(); }
+		bool empty() const { return node_count == 0; }
+		size_type size() const { return node_count; }
+		size_type max_size() const { return size_type(-1) / sizeof(value_type); }
+		void swap(self& x);
+
+		pair<iterator, bool> insert_unique(const value_type& val);
+		iterator insert_equal(const value_type& val);
+		template<class InputIterator>
+		void insert_unique(InputIterator first, InputIterator last)
+		{
+			for (; first != last; ++first)
+				insert_unique(*first);
+		}
+		template<class InputIterator>
+		void insert_equal(InputIterator first, InputIterator last)
+		{
+			for (; first != last; ++first)
+				insert_equal(*first);
+		}
+
+		iterator erase(iterator pos);             // 返回被删除元素的下一个元素
+		iterator erase(iterator first, iterator last);
+		size_type erase(const key_type& key);     // 删除所有键值为key的元素，返回删除的个数
+		void clear();
+
+		iterator find(const key_type& key);
+		const_iterator find(const key_type& key) const { return const_cast<self*>(this)->find(key); }
+		size_type count(const key_type& key) const;
+		iterator lower_bound(const key_type& key);
+		iterator upper_bound(const key_type& key);
+		const_iterator lower_bound(const key_type& key) const { return const_cast<self*>(this)->lower_bound(key); }
+		const_iterator upper_bound(const key_type& key) const { return const_cast<self*>(this)->upper_bound(key); }
+		pair<iterator, iterator> equal_range(const key_type& key)
+		{
+			return pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+		}
+		pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			return pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+		}
+
+		bool operator == (const self& x) const;
+		bool operator != (const self& x) const { return !(*this == x); }
+
+		size_type height() const;    // 树的层数，空树为0
+
+	private:
+		const key_type& key(node* x, size_type i) const { return get_key(x->value(i)); }
+		size_type lower_index(node* x, const key_type& k) const;    // 节点中第一个不小于k的下标
+		size_type upper_index(node* x, const key_type& k) const;    // 节点中第一个大于k的下标
+
+		iterator insert_leaf(node* x, size_type i, const value_type& val);   // 在叶节点x的下标i处插入
+		void split(node*& x, size_type& i);      // 分裂已满的x，x、i更新为原来的下标i所在的节点和下标
+		void rebalance(node* x, iterator& it);   // 删除之后x的元素不足，借或者合并，it随元素一起移动
+		void rotate_right(node* p, size_type k, iterator& it);   // children[k]的最后一个元素经过父节点移到children[k + 1]
+		void rotate_left(node* p, size_type k);                  // children[k + 1]的第一个元素经过父节点移到children[k]的末尾，it不受影响
+		void merge(node* p, size_type k, iterator& it);          // 把values[k]和children[k + 1]并入children[k]
+
+		static void move_value(node* dst, size_type j, node* src, size_type i);   // 把src[i]移到dst[j]（未构造的位置）
+		template<class V>
+		static void move_construct(V* p, V& x) { new (p) V(std::move(x)); }
+		// map的value_type为pair<const K, T>，key是const的，直接移动只能复制key；
+		// pair<const K, T>与pair<K, T>的布局相同，当作pair<K, T>移动，key也不用复制（string作key时省掉一次分配）
+		template<class K, class T>
+		static void move_construct(pair<const K, T>* p, pair<const K, T>& x)
+		{
+			new (static_cast<void*>(p)) pair<K, T>(std::move(reinterpret_cast<pair<K, T>&>(x)));
+		}
+		static void set_child(node* p, size_type i, node* c)
+		{
+			p->child(i) = c;
+			c->parent = p;
+			c->position = static_cast<unsigned short>(i);
+		}
+		static node* leftmost_leaf(node* x)
+		{
+			while (!x->leaf)
+				x = x->child(0);
+			return x;
+		}
+		static node* rightmost_leaf(node* x)
+		{
+			while (!x->leaf)
+				x = x->child(x->count);
+			return x;
+		}
+
+		node* new_node(bool leaf);
+		void free_node(node* x);
+		node* copy_tree(node* x, node* parent);
+		void destroy_tree(node* x);
+	};
+
+}   // namespace TinySTL
+
+#include "./Detail/Btree.impl.h"
+
+#endif // !_BTREE_H_
@@ -0,0 +1,179 @@
+#ifndef _BTREE_MAP_H_
+#define _BTREE_MAP_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include "Btree.h"
+
+/*
+*  btree_map、btree_multimap以btree为底层，map、multimap以rb_tree为底层
+*  两者的使用方法和接口相同，元素pair<const Key, T>按key排序，
+*  btree_map的元素连续地放在节点中，占用的内存少，查找、顺序遍历时的cache miss也少得多
+*  最后一个模板参数NodeBytes为每个节点大约占用的字节数，默认256字节，元素很大时可以调大（比如4096，一页）
+*  区别：插入、删除之后，btree_map原有的迭代器、指针、引用（包括operator[]返回的引用）都会失效
+*/
+
+namespace TinySTL
+{
+	/*********************** class btree_map *****************************/
+	template<class Key, class T, class Compare = less<Key>, size_t NodeBytes = 256>
+	class btree_map
+	{
+	public:
+		typedef Key                  key_type;
+		typedef T                    data_type;
+		typedef T                    mapped_type;
+		typedef pair<const Key, T>   value_type;
+		typedef Compare              key_compare;
+
+	private:
+		typedef btree<key_type, value_type, select1st<value_type>, key_compare, NodeBytes>  rep_type;
+		rep_type t;
+
+	public:
+		typedef typename rep_type::iterator            iterator;
+		typedef typename rep_type::const_iterator      const_iterator;
+		typedef typename rep_type::pointer             pointer;
+		typedef typename rep_type::const_pointer       const_pointer;
+		typedef typename rep_type::reference           reference;
+		typedef typename rep_type::const_reference     const_reference;
+		typedef typename rep_type::size_type           size_type;
+		typedef typename rep_type::difference_type     difference_type;
+
+	public:
+		btree_map() : t(key_compare()) { }
+		explicit btree_map(const Compare& cmp) : t(cmp) { }
+		template<class InputIterator>
+		btree_map(InputIterator first, InputIterator last) : t(key_compare()) { t.insert_unique(first, last); }
+
+		key_compare key_comp() const { return t.key_comp(); }
+		iterator begin() { return t.begin(); }
+		iterator end() { return t.end(); }
+		const_iterator begin() const { return t.begin(); }
+		const_iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		void swap(btree_map& x) { t.swap(x.t); }
+
+		T& operator [] (const key_type& k)
+		{
+			iterator it = t.lower_bound(k);
+			if (it == t.end() || key_comp()(k, it->first))   // 没找到
+				it = t.insert_unique(value_type(k, T())).first;
+			return it->second;
+		}
+
+		pair<iterator, bool> insert(const value_type& x) { return t.insert_unique(x); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_unique(first, last); }
+		iterator erase(iterator pos) { return t.erase(pos); }
+		size_type erase(const key_type& k) { return t.erase(k); }
+		iterator erase(iterator first, iterator last) { return t.erase(first, last); }
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& k) { return t.find(k); }
+		const_iterator find(const key_type& k) const { return t.find(k); }
+		size_type count(const key_type& k) const { return t.find(k) == t.end() ? 0 : 1; }
+		iterator lower_bound(const key_type& k) { return t.lower_bound(k); }
+		const_iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+		iterator upper_bound(const key_type& k) { return t.upper_bound(k); }
+		const_iterator upper_bound(const key_type& k) const { return t.upper_bound(k); }
+		pair<iterator, iterator> equal_range(const key_type& k) { return t.equal_range(k); }
+		pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return t.equal_range(k); }
+
+		bool operator == (const btree_map& y) const { return t == y.t; }
+		bool operator != (const btree_map& y) const { return !(t == y.t); }
+	};
+
+	template<class Key, class T, class Compare, size_t NodeBytes>
+	bool operator == (const btree_map<Key, T, Compare, NodeBytes>& x, const btree_map<Key, T, Compare, NodeBytes>& y)
+	{
+		return x.operator==(y);
+	}
+	template<class Key, class T, class Compare, size_t NodeBytes>
+	bool operator != (const btree_map<Key, T, Compare, NodeBytes>& x, const btree_map<Key, T, Compare, NodeBytes>& y)
+	{
+		return x.operator!=(y);
+	}
+
+	/*********************** class btree_multimap *****************************/
+	template<class Key, class T, class Compare = less<Key>, size_t NodeBytes = 256>
+	class btree_multimap
+	{
+	public:
+		typedef Key                  key_type;
+		typedef T                    data_type;
+		typedef T                    mapped_type;
+		typedef pair<const Key, T>   value_type;
+		typedef Compare              key_compare;
+
+	private:
+		typedef btree<key_type, value_type, select1st<value_type>, key_compare, NodeBytes>  rep_type;
+		rep_type t;
+
+	public:
+		typedef typename rep_type::iterator            iterator;
+		typedef typename rep_type::const_iterator      const_iterator;
+		typedef typename rep_type::pointer             pointer;
+		typedef typename rep_type::const_pointer       const_pointer;
+		typedef typename rep_type::reference           reference;
+		typedef typename rep_type::const_reference     const_reference;
+		typedef typename rep_type::size_type           size_type;
+		typedef typename rep_type::difference_type     difference_type;
+
+	public:
+		btree_multimap() : t(key_compare()) { }
+		explicit btree_multimap(const Compare& cmp) : t(cmp) { }
+		template<class InputIterator>
+		btree_multimap(InputIterator first, InputIterator last) : t(key_compare()) { t.insert_equal(first, last); }
+
+		key_compare key_comp() const { return t.key_comp(); }
+		iterator begin() { return t.begin(); }
+		iterator end() { return t.end(); }
+		const_iterator begin() const { return t.begin(); }
+		const_iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		void swap(btree_multimap& x) { t.swap(x.t); }
+
+		iterator insert(const value_type& x) { return t.insert_equal(x); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_equal(first, last); }
+		iterator erase(iterator pos) { return t.erase(pos); }
+		size_type erase(const key_type& k) { return t.erase(k); }
+		iterator erase(iterator first, iterator last) { return t.erase(first, last); }
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& k) { return t.find(k); }
+		const_iterator find(const key_type& k) const { return t.find(k); }
+		size_type count(const key_type& k) const { return t.count(k); }
+		iterator lower_bound(const key_type& k) { return t.lower_bound(k); }
+		const_iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+		iterator upper_bound(const key_type& k) { return t.upper_bound(k); }
+		const_iterator upper_bound(const key_type& k) const { return t.upper_bound(k); }
+		pair<iterator, iterator> equal_range(const key_type& k) { return t.equal_range(k); }
+		pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return t.equal_range(k); }
+
+		bool operator == (const btree_multimap& y) const { return t == y.t; }
+		bool operator != (const btree_multimap& y) const { return !(t == y.t); }
+	};
+
+	template<class Key, class T, class Compare, size_t NodeBytes>
+	bool operator == (const btree_multimap<Key, T, Compare, NodeBytes>& x, const btree_multimap<Key, T, Compare, NodeBytes>& y)
+	{
+		return x.operator==(y);
+	}
+	template<class Key, class T, class Compare, size_t NodeBytes>
+	bool operator != (const btree_multimap<Key, T, Compare, NodeBytes>& x, const btree_multimap<Key, T, Compare, NodeBytes>& y)
+	{
+		return x.operator!=(y);
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_BTREE_MAP_H_
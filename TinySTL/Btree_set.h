@@ -0,0 +1,167 @@
+#ifndef _BTREE_SET_H_
+#define _BTREE_SET_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include "Btree.h"
+
+/*
+*  btree_set、btree_multiset以btree为底层，set、multiset以rb_tree为底层
+*  两者的使用方法和接口相同，元素都是有序的，查找都是O(logN)，
+*  btree_set的元素连续地放在节点中，占用的内存少，查找、顺序遍历时的cache miss也少得多
+*  最后一个模板参数NodeBytes为每个节点大约占用的字节数，默认256字节，元素很大时可以调大（比如4096，一页）
+*  区别：插入、删除之后，btree_set原有的迭代器、指针、引用都会失效
+*/
+
+namespace TinySTL
+{
+	/*********************** class btree_set *****************************/
+	template<class Key, class Compare = less<Key>, size_t NodeBytes = 256>
+	class btree_set
+	{
+	public:
+		typedef Key      key_type;           // 在set中，key即是value
+		typedef Key      value_type;
+		typedef Compare  key_compare;
+		typedef Compare  value_compare;
+
+	private:
+		typedef btree<Key, Key, identity<Key>, Compare, NodeBytes>   rep_type;
+
+		rep_type t;
+	public:
+		typedef typename rep_type::const_iterator     iterator;        // 不允许通过迭代器修改元素
+		typedef typename rep_type::const_iterator     const_iterator;
+		typedef typename rep_type::const_pointer      pointer;
+		typedef typename rep_type::const_pointer      const_pointer;
+		typedef typename rep_type::const_reference    reference;
+		typedef typename rep_type::const_reference    const_reference;
+		typedef typename rep_type::size_type          size_type;
+		typedef typename rep_type::difference_type    difference_type;
+	private:
+		typedef typename rep_type::iterator           rep_iterator;
+
+	public:
+		btree_set() : t(Compare()) { }
+		explicit btree_set(const Compare& cmp) : t(cmp) { }
+		template<class InputIterator>
+		btree_set(InputIterator first, InputIterator last) : t(Compare()) { t.insert_unique(first, last); }
+
+		key_compare key_comp() const { return t.key_comp(); }
+		value_compare value_comp() const { return t.key_comp(); }
+		iterator begin() const { return t.begin(); }
+		iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		void swap(btree_set& x) { t.swap(x.t); }
+
+		pair<iterator, bool> insert(const value_type& val)
+		{
+			pair<rep_iterator, bool> p = t.insert_unique(val);
+			return pair<iterator, bool>(p.first, p.second);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_unique(first, last); }
+		iterator erase(iterator pos) { return t.erase(rep_iterator(pos.nd, pos.pos)); }
+		size_type erase(const key_type& key) { return t.erase(key); }
+		iterator erase(iterator first, iterator last) { return t.erase(rep_iterator(first.nd, first.pos), rep_iterator(last.nd, last.pos)); }
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& key) const { return t.find(key); }
+		size_type count(const key_type& key) const { return t.find(key) == t.end() ? 0 : 1; }
+		iterator lower_bound(const key_type& key) const { return t.lower_bound(key); }
+		iterator upper_bound(const key_type& key) const { return t.upper_bound(key); }
+		pair<iterator, iterator> equal_range(const key_type& key) const { return t.equal_range(key); }
+
+		bool operator == (const btree_set& y) const { return t == y.t; }
+		bool operator != (const btree_set& y) const { return !(t == y.t); }
+	};
+
+	template<class Key, class Compare, size_t NodeBytes>
+	bool operator == (const btree_set<Key, Compare, NodeBytes>& x, const btree_set<Key, Compare, NodeBytes>& y)
+	{
+		return x.operator==(y);
+	}
+	template<class Key, class Compare, size_t NodeBytes>
+	bool operator != (const btree_set<Key, Compare, NodeBytes>& x, const btree_set<Key, Compare, NodeBytes>& y)
+	{
+		return x.operator!=(y);
+	}
+
+	/*********************** class btree_multiset *****************************/
+	template<class Key, class Compare = less<Key>, size_t NodeBytes = 256>
+	class btree_multiset
+	{
+	public:
+		typedef Key      key_type;
+		typedef Key      value_type;
+		typedef Compare  key_compare;
+		typedef Compare  value_compare;
+
+	private:
+		typedef btree<Key, Key, identity<Key>, Compare, NodeBytes>   rep_type;
+
+		rep_type t;
+	public:
+		typedef typename rep_type::const_iterator     iterator;
+		typedef typename rep_type::const_iterator     const_iterator;
+		typedef typename rep_type::const_pointer      pointer;
+		typedef typename rep_type::const_pointer      const_pointer;
+		typedef typename rep_type::const_reference    reference;
+		typedef typename rep_type::const_reference    const_reference;
+		typedef typename rep_type::size_type          size_type;
+		typedef typename rep_type::difference_type    difference_type;
+	private:
+		typedef typename rep_type::iterator           rep_iterator;
+
+	public:
+		btree_multiset() : t(Compare()) { }
+		explicit btree_multiset(const Compare& cmp) : t(cmp) { }
+		template<class InputIterator>
+		btree_multiset(InputIterator first, InputIterator last) : t(Compare()) { t.insert_equal(first, last); }
+
+		key_compare key_comp() const { return t.key_comp(); }
+		value_compare value_comp() const { return t.key_comp(); }
+		iterator begin() const { return t.begin(); }
+		iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		void swap(btree_multiset& x) { t.swap(x.t); }
+
+		iterator insert(const value_type& val) { return t.insert_equal(val); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_equal(first, last); }
+		iterator erase(iterator pos) { return t.erase(rep_iterator(pos.nd, pos.pos)); }
+		size_type erase(const key_type& key) { return t.erase(key); }
+		iterator erase(iterator first, iterator last) { return t.erase(rep_iterator(first.nd, first.pos), rep_iterator(last.nd, last.pos)); }
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& key) const { return t.find(key); }
+		size_type count(const key_type& key) const { return t.count(key); }
+		iterator lower_bound(const key_type& key) const { return t.lower_bound(key); }
+		iterator upper_bound(const key_type& key) const { return t.upper_bound(key); }
+		pair<iterator, iterator> equal_range(const key_type& key) const { return t.equal_range(key); }
+
+		bool operator == (const btree_multiset& y) const { return t == y.t; }
+		bool operator != (const btree_multiset& y) const { return !(t == y.t); }
+	};
+
+	template<class Key, class Compare, size_t NodeBytes>
+	bool operator == (const btree_multiset<Key, Compare, NodeBytes>& x, const btree_multiset<Key, Compare, NodeBytes>& y)
+	{
+		return x.operator==(y);
+	}
+	template<class Key, class Compare, size_t NodeBytes>
+	bool operator != (const btree_multiset<Key, Compare, NodeBytes>& x, const btree_multiset<Key, Compare, NodeBytes>& y)
+	{
+		return x.operator!=(y);
+	}
+
+}   // namespace TinySTL
+
+
+#endif // !_BTREE_SET_H_
@@ -0,0 +1,70 @@
+#ifndef _CHARCONV_H_
+#define _CHARCONV_H_
+
+/*
+*	Author  @yyehl
+*/
+
+#include "String.h"
+#include <system_error>
+
+/*
+*  数值与字符串之间的转换，接口与C++17的 <charconv> 一致
+*  to_chars   : 把数值写入调用者提供的缓冲区[first, last)，不追加'\0'，不分配内存
+*  from_chars : 从[first, last)中解析出数值，不要求'\0'结尾，不跳过前导空白，不接受'+'号
+*
+*  整数每次处理两位数字（查两位数字表）
+*  浮点数输出能够精确还原（round-trip）的最短表示，有多个时取离原值最近的（Grisu3，无法确定时用十进制大数精确求解）
+*  浮点数的解析在常见情况下（不超过19位有效数字，10的指数不超过22）直接用一次乘/除得到精确结果，
+*  其余情况用Eisel-Lemire算法，极少数无法确定舍入的长输入再用栈上的十进制大数求解；
+*  都不调用strtod，不受locale影响，也不申请内存
+*/
+
+namespace TinySTL
+{
+	struct to_chars_result
+	{
+		char* ptr;       // 写入的最后一个字符的下一位置，失败时为last
+		std::errc ec;    // 成功为std::errc()，缓冲区不够为std::errc::value_too_large
+	};
+
+	struct from_chars_result
+	{
+		const char* ptr; // 第一个没有被解析的字符，没有匹配到数值时为first
+		std::errc ec;    // 没有匹配到数值为invalid_argument，数值越界为result_out_of_range
+	};
+
+	/*********************** to_chars *****************************/
+	to_chars_result to_chars(char* first, char* last, int value);
+	to_chars_result to_chars(char* first, char* last, unsigned int value);
+	to_chars_result to_chars(char* first, char* last, long value);
+	to_chars_result to_chars(char* first, char* last, unsigned long value);
+	to_chars_result to_chars(char* first, char* last, long long value);
+	to_chars_result to_chars(char* first, char* last, unsigned long long value);
+	to_chars_result to_chars(char* first, char* last, float value);
+	to_chars_result to_chars(char* first, char* last, double value);
+
+	/*********************** from_chars *****************************/
+	from_chars_result from_chars(const char* first, const char* last, int& value);
+	from_chars_result from_chars(const char* first, const char* last, unsigned int& value);
+	from_chars_result from_chars(const char* first, const char* last, long& value);
+	from_chars_result from_chars(const char* first, const char* last, unsigned long& value);
+	from_chars_result from_chars(const char* first, const char* last, long long& value);
+	from_chars_result from_chars(const char* first, const char* last, unsigned long long& value);
+	from_chars_result from_chars(const char* first, const char* last, float& value);
+	from_chars_result from_chars(const char* first, const char* last, double& value);
+
+	/*********************** to_string *****************************/
+	string to_string(int value);
+	string to_string(unsigned int value);
+	string to_string(long value);
+	string to_string(unsigned long value);
+	string to_string(long long value);
+	string to_string(unsigned long long value);
+	string to_string(float value);
+	string to_string(double value);
+
+}  // namespace TinySTL
+
+
+#endif // !_CHARCONV_H_
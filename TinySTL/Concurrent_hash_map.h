@@ -0,0 +1,196 @@
+#ifndef _CONCURRENT_HASH_MAP_H_
+#define _CONCURRENT_HASH_MAP_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include <mutex>
+#include <new>
+
+#include "Hashtable.h"
+
+/*
+*  concurrent_hash_map 是可以被多个线程同时访问的hash_map，采用分段锁（lock striping）
+*
+*  整个表被分成若干段（segment，个数为2的幂），每一段是一个独立的hashtable加一把std::mutex，
+*  key按hash值的低位决定落在哪一段，只有落在同一段的操作才会互相等待，段数越多冲突越少
+*  每段各自扩容，扩容时也只锁住这一段
+*  hash值先经过hash_mix，段号取混合之后的低位；段内默认用prime_rehash_policy对原hash值按质数取模，
+*  换成pow2_rehash_policy时则用fastrange取混合之后的高位，两种情况下段号与段内的bucket都互不相关
+*  每个操作只算一次hash值，选段之后经由find(key, code)、insert_unique(val, code)、erase(it, code)传给段内的hashtable
+*
+*  与hash_map不同，这里不提供迭代器和operator[]：返回的迭代器、引用在解锁之后随时可能失效
+*  find把找到的值拷贝出来，insert_or_update在锁内完成“没有就插入，有就覆盖”
+*  size()依次锁住每一段求和，并发修改时得到的只是一个近似值
+*
+*  TinySTL的alloc（二级空间配置器）用一把全局的自旋锁保护freelist，是线程安全的，key和value的类型本身
+*  用alloc分配内存（比如TinySTL::string）也没有问题；但所有线程都挤在这一把锁上，分段锁就白做了，
+*  所以段内hashtable的节点改用concurrent_node_allocator（::operator new）分配，
+*  每段的buckets至少64个（512字节以上），超过128字节的vector也是直接malloc，不经过alloc的freelist
+*/
+
+namespace TinySTL
+{
+	// 直接使用::operator new / ::operator delete，多线程下安全
+	template<class T>
+	struct concurrent_node_allocator
+	{
+		static T* allocate() { return static_cast<T*>(::operator new(sizeof(T))); }
+		static void deallocate(T* ptr) { ::operator delete(ptr); }
+		static T* allocate(size_t n) { return static_cast<T*>(::operator new(sizeof(T) * n)); }
+		static void deallocate(T* ptr, size_t) { ::operator delete(ptr); }
+	};
+
+	template<class Key, class Value, class Hashfcn = hash<Key>, class Equalkey = equal_to<Key>, class RehashPolicy = prime_rehash_policy>
+	class concurrent_hash_map
+	{
+	private:
+		typedef hashtable<pair<const Key, Value>, Key, Hashfcn, select1st<pair<const Key, Value>>, Equalkey, RehashPolicy, false,
+		                  concurrent_node_allocator<hashtable_node<pair<const Key, Value>>>>    ht;
+
+	public:
+		typedef Value  data_type;
+		typedef typename ht::value_type     value_type;
+		typedef typename ht::key_type       key_type;
+		typedef typename ht::hasher         hasher;
+		typedef typename ht::key_equal      key_equal;
+		typedef typename ht::size_type      size_type;
+
+	private:
+		static const size_type cache_line = 64;
+		static const size_type min_segment_buckets = 64;
+
+		// 每段一把锁，末尾补齐一个cache line，避免相邻两段的锁落在同一个cache line上（false sharing）
+		struct segment
+		{
+			std::mutex lock;
+			ht table;
+			char pad[cache_line];
+
+			segment(size_type n, const hasher& hf, const key_equal& eql) : table(n, hf, eql) { }
+		};
+		typedef allocator<segment>  segment_allocator;
+		typedef std::lock_guard<std::mutex>  lock_guard;
+
+		segment* segs;
+		size_type seg_count;     // 2的幂
+		hasher hash;
+
+	public:
+		// n：预计的元素总个数    concurrency：预计同时访问的线程数，段数取不小于它的2的幂
+		explicit concurrent_hash_map(size_type n = 100, size_type concurrency = 64,
+		                             const hasher& hf = hasher(), const key_equal& eql = key_equal())
+			: segs(nullptr), seg_count(1), hash(hf)
+		{
+			while (seg_count < concurrency)
+				seg_count <<= 1;
+			size_type per_segment = n / seg_count + 1;
+			if (per_segment < min_segment_buckets)
+				per_segment = min_segment_buckets;
+			segs = segment_allocator::allocate(seg_count);
+			for (size_type i = 0; i != seg_count; ++i)
+				new (segs + i) segment(per_segment, hf, eql);
+		}
+		~concurrent_hash_map()
+		{
+			for (size_type i = 0; i != seg_count; ++i)
+				destroy(segs + i);
+			segment_allocator::deallocate(segs, seg_count);
+		}
+
+		concurrent_hash_map(const concurrent_hash_map&) = delete;
+		concurrent_hash_map& operator = (const concurrent_hash_map&) = delete;
+
+		hasher hash_funct() const { return hash; }
+		size_type segments_count() const { return seg_count; }
+
+	public:
+		// 找到时把value拷贝到out中并返回true
+		bool find(const key_type& key, data_type& out) const
+		{
+			const size_type code = hash(key);
+			segment& seg = segment_of(code);
+			lock_guard guard(seg.lock);
+			typename ht::iterator it = seg.table.find(key, code);
+			if (it == seg.table.end())
+				return false;
+			out = it->second;
+			return true;
+		}
+		size_type count(const key_type& key) const
+		{
+			const size_type code = hash(key);
+			segment& seg = segment_of(code);
+			lock_guard guard(seg.lock);
+			return seg.table.find(key, code) == seg.table.end() ? 0 : 1;
+		}
+		bool contains(const key_type& key) const { return count(key) != 0; }
+
+		// 已经存在时不插入，返回false
+		bool insert_unique(const value_type& val)
+		{
+			const size_type code = hash(val.first);
+			segment& seg = segment_of(code);
+			lock_guard guard(seg.lock);
+			return seg.table.insert_unique(val, code).second;
+		}
+		// 不存在时插入并返回true，已经存在时覆盖原有的value并返回false
+		bool insert_or_update(const key_type& key, const data_type& data)
+		{
+			const size_type code = hash(key);
+			segment& seg = segment_of(code);
+			lock_guard guard(seg.lock);
+			typename ht::iterator it = seg.table.find(key, code);
+			if (it != seg.table.end())
+			{
+				it->second = data;
+				return false;
+			}
+			seg.table.insert_unique(value_type(key, data), code);
+			return true;
+		}
+		// 返回删除的元素个数（0或1）
+		size_type erase(const key_type& key)
+		{
+			const size_type code = hash(key);
+			segment& seg = segment_of(code);
+			lock_guard guard(seg.lock);
+			typename ht::iterator it = seg.table.find(key, code);
+			if (it == seg.table.end())
+				return 0;
+			seg.table.erase(it, code);
+			return 1;
+		}
+
+		size_type size() const
+		{
+			size_type ret = 0;
+			for (size_type i = 0; i != seg_count; ++i)
+			{
+				lock_guard guard(segs[i].lock);
+				ret += segs[i].table.size();
+			}
+			return ret;
+		}
+		bool empty() const { return size() == 0; }
+		void clear()
+		{
+			for (size_type i = 0; i != seg_count; ++i)
+			{
+				lock_guard guard(segs[i].lock);
+				segs[i].table.clear();
+			}
+		}
+
+	private:
+		segment& segment_of(size_type code) const    // code为key的hash值
+		{
+			return segs[hash_mix(code) & (seg_count - 1)];
+		}
+	};
+
+}  // namespace TinySTL
+
+
+#endif // !_CONCURRENT_HASH_MAP_H_
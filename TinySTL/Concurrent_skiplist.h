@@ -0,0 +1,229 @@
+#ifndef _CONCURRENT_SKIPLIST_H_
+#define _CONCURRENT_SKIPLIST_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "Functional.h"
+#include "Utility.h"
+#include "Construct.h"
+
+/*
+*  concurrent_skiplist 是可以被多个线程同时读写的有序表（lazy skip list），
+*  concurrent_skiplist_map、concurrent_skiplist_set以它为底层
+*
+*  rb_tree插入、删除时的旋转会改动整条路径，只能整棵树一把锁；跳表插入、删除只改动前驱节点的next指针，
+*  所以每个节点带一把自旋锁，只锁住要修改的几个前驱节点，落在不同位置的写操作互不等待
+*  查找、遍历完全不加锁：节点先把自己的next都设好，才链接到前驱上（fully_linked），删除时先打上标记（marked）再摘下
+*
+*  被删除的节点不能马上释放，别的线程可能正走到它上面；这里用epoch回收：
+*  每个操作开始时登记在当前epoch中，结束时注销，删除的节点挂在它所在epoch的回收链表上，
+*  某个epoch中登记的操作全部结束后epoch才能前进，前进两次之后那个epoch中删除的节点就没有人能访问到了，再真正释放
+*  登记用的计数器分成若干个cache line对齐的分片，各线程落在不同的分片上，不会都挤在同一个计数器上
+*
+*  与concurrent_hash_map相同，这里不提供迭代器：返回的迭代器在操作结束之后随时可能失效
+*  find把找到的值拷贝出来，for_each在一次登记中按顺序遍历（遍历过程中插入、删除的元素可能看到也可能看不到）
+*  size()是一个原子计数器，并发修改时只是一个近似值；clear()不能与其他操作同时进行
+*
+*  节点用::operator new分配，不经过alloc：alloc是线程安全的，但所有线程共用一把锁；
+*  key和value本身用alloc分配内存（比如TinySTL::string）也没有问题
+*/
+
+namespace TinySTL
+{
+	/*********************** class skiplist_node *****************************/
+	template<class Value>
+	struct skiplist_node
+	{
+		Value value;
+		std::atomic<bool> marked;         // 已经被逻辑删除
+		std::atomic<bool> fully_linked;   // 各层都已链接好，可以被看到
+		std::atomic<bool> locked;         // 自旋锁
+		int height;                       // 层数，next的实际长度
+		skiplist_node* retired_next;      // 在回收链表中的下一个节点，不能复用next，别的线程可能还在沿next前进
+		std::atomic<skiplist_node*> next[1];
+	};
+
+	/*********************** class concurrent_skiplist *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	class concurrent_skiplist
+	{
+	public:
+		typedef Key           key_type;
+		typedef Value         value_type;
+		typedef Compare       key_compare;
+		typedef size_t        size_type;
+
+		static const int max_level = 16;     // 每升一层的概率为1/4，16层足以容纳4^16个元素
+
+	private:
+		typedef skiplist_node<Value>  node;
+
+		static const size_type cache_line = 64;
+		static const size_type stripes = 16;
+
+		// 每个分片独占一个cache line，避免false sharing
+		struct stripe_counter
+		{
+			std::atomic<size_type> n;
+			char pad[cache_line - sizeof(std::atomic<size_type>)];
+		};
+
+		// 在构造时登记到当前epoch，析构时注销；登记期间访问到的节点都不会被释放
+		class epoch_guard
+		{
+		public:
+			explicit epoch_guard(const concurrent_skiplist& sl) : l(sl) { e = l.enter(s); }
+			~epoch_guard() { l.leave(e, s); }
+			size_type epoch() const { return e; }
+		private:
+			const concurrent_skiplist& l;
+			size_type e;
+			size_type s;
+		};
+
+		node* head;              // 哨兵，有max_level层，不构造value
+		Compare comp;
+		std::atomic<size_type> count;
+
+		mutable std::atomic<size_type> global_epoch;
+		mutable stripe_counter active[3][stripes];    // 各epoch中尚未结束的操作数，只用到当前和前两个epoch
+		std::atomic<node*> retired[3];                // 各epoch中删除的节点
+		std::mutex reclaim_lock;
+
+	public:
+		explicit concurrent_skiplist(const Compare& cmp = Compare());
+		~concurrent_skiplist();
+
+		concurrent_skiplist(const concurrent_skiplist&) = delete;
+		concurrent_skiplist& operator = (const concurrent_skiplist&) = delete;
+
+		key_compare key_comp() const { return comp; }
+
+		// 找到时以找到的元素调用f并返回true，f在登记期间执行，元素不会被释放
+		template<class Func>
+		bool visit(const key_type& k, Func f) const;
+		bool contains(const key_type& k) const;
+		size_type count_of(const key_type& k) const { return contains(k) ? 1 : 0; }
+
+		bool insert_unique(const value_type& val);   // 已经存在时不插入，返回false
+		size_type erase(const key_type& k);          // 返回删除的元素个数（0或1）
+
+		// 按键值从小到大对每个元素调用f；第二个版本只遍历键值在[lo, hi)中的元素
+		template<class Func>
+		void for_each(Func f) const;
+		template<class Func>
+		void for_each(const key_type& lo, const key_type& hi, Func f) const;
+
+		size_type size() const { return count.load(std::memory_order_relaxed); }
+		bool empty() const { return size() == 0; }
+		void clear();
+
+	private:
+		static const key_type& key(const node* x) { return KeyOfValue()(x->value); }
+		static node* allocate_node(int height);
+		static node* create_node(const value_type& val, int height);
+		static void destroy_node(node* x);
+		static void lock(node* x);
+		static void unlock(node* x) { x->locked.store(false, std::memory_order_release); }
+		static int random_level();
+		static size_type stripe_index();
+
+		// 每层最后一个小于k的节点记在preds中，其后继记在succs中，返回找到k的最高层，没找到返回-1
+		int find_node(const key_type& k, node** preds, node** succs) const;
+		node* first_not_less(const key_type& k) const;   // 第0层第一个键值不小于k的节点
+		static void unlock_preds(node** preds, int highest);
+
+		size_type enter(size_type& s) const;
+		void leave(size_type e, size_type s) const { active[e % 3][s].n.fetch_sub(1, std::memory_order_release); }
+		void retire(node* x, size_type e);
+		void try_reclaim();
+		static void free_list(node* x);
+	};
+
+	/*********************** class concurrent_skiplist_map *****************************/
+	template<class Key, class T, class Compare = less<Key>>
+	class concurrent_skiplist_map
+	{
+	private:
+		typedef concurrent_skiplist<Key, pair<const Key, T>, select1st<pair<const Key, T>>, Compare>  rep_type;
+		rep_type t;
+
+	public:
+		typedef Key                                 key_type;
+		typedef T                                   data_type;
+		typedef T                                   mapped_type;
+		typedef typename rep_type::value_type       value_type;
+		typedef Compare                             key_compare;
+		typedef typename rep_type::size_type        size_type;
+
+		concurrent_skiplist_map() : t(Compare()) { }
+		explicit concurrent_skiplist_map(const Compare& cmp) : t(cmp) { }
+
+		key_compare key_comp() const { return t.key_comp(); }
+
+		// 找到时把value拷贝到out中并返回true
+		bool find(const key_type& k, data_type& out) const { return t.visit(k, [&out](const value_type& v) { out = v.second; }); }
+		size_type count(const key_type& k) const { return t.count_of(k); }
+		bool contains(const key_type& k) const { return t.contains(k); }
+
+		bool insert_unique(const value_type& val) { return t.insert_unique(val); }
+		size_type erase(const key_type& k) { return t.erase(k); }
+
+		template<class Func>
+		void for_each(Func f) const { t.for_each(f); }
+		template<class Func>
+		void for_each(const key_type& lo, const key_type& hi, Func f) const { t.for_each(lo, hi, f); }
+
+		size_type size() const { return t.size(); }
+		bool empty() const { return t.empty(); }
+		void clear() { t.clear(); }
+	};
+
+	/*********************** class concurrent_skiplist_set *****************************/
+	template<class Key, class Compare = less<Key>>
+	class concurrent_skiplist_set
+	{
+	private:
+		typedef concurrent_skiplist<Key, Key, identity<Key>, Compare>  rep_type;
+		rep_type t;
+
+	public:
+		typedef Key                                 key_type;
+		typedef Key                                 value_type;
+		typedef Compare                             key_compare;
+		typedef Compare                             value_compare;
+		typedef typename rep_type::size_type        size_type;
+
+		concurrent_skiplist_set() : t(Compare()) { }
+		explicit concurrent_skiplist_set(const Compare& cmp) : t(cmp) { }
+
+		key_compare key_comp() const { return t.key_comp(); }
+
+		size_type count(const key_type& k) const { return t.count_of(k); }
+		bool contains(const key_type& k) const { return t.contains(k); }
+
+		bool insert(const value_type& val) { return t.insert_unique(val); }
+		size_type erase(const key_type& k) { return t.erase(k); }
+
+		template<class Func>
+		void for_each(Func f) const { t.for_each(f); }
+		template<class Func>
+		void for_each(const key_type& lo, const key_type& hi, Func f) const { t.for_each(lo, hi, f); }
+
+		size_type size() const { return t.size(); }
+		bool empty() const { return t.empty(); }
+		void clear() { t.clear(); }
+	};
+
+}  // namespace TinySTL
+
+#include "./Detail/Concurrent_skiplist.impl.h"
+
+#endif // !_CONCURRENT_SKIPLIST_H_
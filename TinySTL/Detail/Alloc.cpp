@@ -1,10 +1,27 @@
 #include "../Alloc.h"
 
+#include <atomic>
+#include <thread>
+
 /*
 *        Author  @yyehl
 */
 
 namespace TinySTL {
+
+	namespace {
+		// freelistڴ̹߳_allocate_deallocateжǵĲҪ
+		// ٽֻмָrefillchunk_allocżmallocʱóʱƬ
+		std::atomic_flag free_list_lock = ATOMIC_FLAG_INIT;
+
+		struct free_list_guard {
+			free_list_guard() {
+				while (free_list_lock.test_and_set(std::memory_order_acquire))
+					std::this_thread::yield();
+			}
+			~free_list_guard() { free_list_lock.clear(std::memory_order_release); }
+		};
+	}
 	
 	char* alloc::start_free = 0;  
 	char* alloc::end_free = 0; 
@@ -18,6 +35,7 @@ namespace TinySTL {
 			return malloc(bytes);             // ֱʹõһmalloc 
 		}                                     //  ҪĿռС128bytes 
 		size_t index = FREELIST_INDEX(bytes); // ʹõڶռ 
+		free_list_guard guard;
 		obj* list = free_list[index];
 		if (list) {                           // freelistпռ 
 			free_list[index] = list->next;    // freelistеָ룬ʹָһõĿռ 
@@ -34,6 +52,7 @@ namespace TinySTL {
 		else {                                // С128bytesյfreelist 
 			size_t index = FREELIST_INDEX(bytes);
 			obj* node = static_cast<obj* >(ptr);
+			free_list_guard guard;
 			node->next = free_list[index];
 			free_list[index] = node;
 		}
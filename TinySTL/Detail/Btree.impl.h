@@ -0,0 +1,528 @@
+#ifndef _BTREE_IMPL_H_
+#define _BTREE_IMPL_H_
+
+/*
+*    Author  @yyehl
+*/
+
+namespace TinySTL
+{
+	/*************** struct btree_iterator ******************************/
+	template<class Value, class Ref, class Ptr, size_t NodeBytes>
+	void btree_iterator<Value, Ref, Ptr, NodeBytes>::increase()
+	{
+		if (!nd->leaf)             // 1：内部节点，下一个元素是children[pos + 1]中最小的元素
+		{
+			nd = nd->child(pos + 1);
+			while (!nd->leaf)
+				nd = nd->child(0);
+			pos = 0;
+			return;
+		}
+		if (++pos < nd->count)     // 2：叶节点中还有元素
+			return;
+		node* x = nd;              // 3：叶节点走完了，向上找到第一个还没走完的祖先
+		size_type i = pos;
+		while (i == x->count && x->parent != nullptr)
+		{
+			i = x->position;
+			x = x->parent;
+		}
+		if (i != x->count)         // 走到根节点都没有，说明nd是最右的叶节点，停在end()上
+		{
+			nd = x;
+			pos = i;
+		}
+	}
+	template<class Value, class Ref, class Ptr, size_t NodeBytes>
+	void btree_iterator<Value, Ref, Ptr, NodeBytes>::decrease()
+	{
+		if (!nd->leaf)             // 1：内部节点，前一个元素是children[pos]中最大的元素
+		{
+			nd = nd->child(pos);
+			while (!nd->leaf)
+				nd = nd->child(nd->count);
+			pos = nd->count - 1;
+			return;
+		}
+		if (pos != 0)              // 2：叶节点中前面还有元素
+		{
+			--pos;
+			return;
+		}
+		while (pos == 0 && nd->parent != nullptr)   // 3：向上找到第一个左边还有元素的祖先
+		{
+			pos = nd->position;
+			nd = nd->parent;
+		}
+		--pos;
+	}
+
+	/************************* class btree **************************************/
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	btree<Key, Value, KeyOfValue, Compare, NodeBytes>::btree(const self& x)
+		: root(nullptr), leftmost(nullptr), rightmost(nullptr), node_count(0), comp(x.comp), get_key(x.get_key)
+	{
+		if (x.root == nullptr)
+			return;
+		root = copy_tree(x.root, nullptr);
+		leftmost = leftmost_leaf(root);
+		rightmost = rightmost_leaf(root);
+		node_count = x.node_count;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::operator = (const self& x) -> self&
+	{
+		if (this != &x)
+		{
+			self tmp(x);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::swap(self& x)
+	{
+		TinySTL::swap(root, x.root);
+		TinySTL::swap(leftmost, x.leftmost);
+		TinySTL::swap(rightmost, x.rightmost);
+		TinySTL::swap(node_count, x.node_count);
+		TinySTL::swap(comp, x.comp);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::clear()
+	{
+		if (root != nullptr)
+			destroy_tree(root);
+		root = leftmost = rightmost = nullptr;
+		node_count = 0;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::lower_index(node* x, const key_type& k) const -> size_type
+	{
+		size_type lo = 0, hi = x->count;
+		while (lo < hi)
+		{
+			size_type mid = (lo + hi) / 2;
+			if (comp(key(x, mid), k))
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::upper_index(node* x, const key_type& k) const -> size_type
+	{
+		size_type lo = 0, hi = x->count;
+		while (lo < hi)
+		{
+			size_type mid = (lo + hi) / 2;
+			if (comp(k, key(x, mid)))
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+		return lo;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::lower_bound(const key_type& k) -> iterator
+	{
+		iterator ret = end();
+		for (node* x = root; x != nullptr; )
+		{
+			size_type i = lower_index(x, k);
+			if (i != x->count)      // x->value(i)不小于k，更深处找到的只会更小
+				ret = iterator(x, i);
+			if (x->leaf)
+				break;
+			x = x->child(i);
+		}
+		return ret;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::upper_bound(const key_type& k) -> iterator
+	{
+		iterator ret = end();
+		for (node* x = root; x != nullptr; )
+		{
+			size_type i = upper_index(x, k);
+			if (i != x->count)
+				ret = iterator(x, i);
+			if (x->leaf)
+				break;
+			x = x->child(i);
+		}
+		return ret;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::find(const key_type& k) -> iterator
+	{
+		iterator it = lower_bound(k);
+		return (it == end() || comp(k, get_key(*it))) ? end() : it;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::count(const key_type& k) const -> size_type
+	{
+		size_type n = 0;
+		const_iterator last = upper_bound(k);
+		for (const_iterator it = lower_bound(k); it != last; ++it)
+			++n;
+		return n;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::insert_unique(const value_type& val) -> pair<iterator, bool>
+	{
+		if (root == nullptr)
+			root = leftmost = rightmost = new_node(true);
+		const key_type& k = get_key(val);
+		node* x = root;
+		while (true)
+		{
+			size_type i = lower_index(x, k);
+			if (i != x->count && !comp(k, key(x, i)))   // 已经存在
+				return pair<iterator, bool>(iterator(x, i), false);
+			if (x->leaf)
+				return pair<iterator, bool>(insert_leaf(x, i, val), true);
+			x = x->child(i);
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::insert_equal(const value_type& val) -> iterator
+	{
+		if (root == nullptr)
+			root = leftmost = rightmost = new_node(true);
+		const key_type& k = get_key(val);
+		node* x = root;
+		while (true)     // 相等的元素插在已有元素的后面
+		{
+			size_type i = upper_index(x, k);
+			if (x->leaf)
+				return insert_leaf(x, i, val);
+			x = x->child(i);
+		}
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::insert_leaf(node* x, size_type i, const value_type& val) -> iterator
+	{
+		if (x->count == capacity)
+			split(x, i);
+		for (size_type j = x->count; j > i; --j)
+			move_value(x, j, x, j - 1);
+		construct(x->value_ptr(i), val);
+		++x->count;
+		++node_count;
+		return iterator(x, i);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::split(node*& x, size_type& i)
+	{
+		if (x->parent == nullptr)       // x为根节点，先加一层新的根节点
+		{
+			node* r = new_node(false);
+			set_child(r, 0, x);
+			root = r;
+		}
+		else if (x->parent->count == capacity)   // 父节点也满了，先分裂父节点，之后x的parent、position可能改变
+		{
+			node* p = x->parent;
+			size_type pi = x->position;
+			split(p, pi);
+		}
+
+		node* p = x->parent;
+		size_type pi = x->position;
+		node* y = new_node(x->leaf);
+		const size_type mid = capacity / 2;     // values[mid]上移到父节点，后面的元素移到y中
+		for (size_type j = mid + 1; j != capacity; ++j)
+			move_value(y, j - mid - 1, x, j);
+		if (!x->leaf)
+		{
+			for (size_type j = mid + 1; j <= capacity; ++j)
+				set_child(y, j - mid - 1, x->child(j));
+		}
+		y->count = static_cast<unsigned short>(capacity - mid - 1);
+
+		for (size_type j = p->count; j > pi; --j)     // 父节点中腾出values[pi]和children[pi + 1]
+		{
+			move_value(p, j, p, j - 1);
+			set_child(p, j + 1, p->child(j));
+		}
+		move_value(p, pi, x, mid);
+		set_child(p, pi + 1, y);
+		++p->count;
+		x->count = static_cast<unsigned short>(mid);
+
+		if (x == rightmost)
+			rightmost = y;
+		if (i > mid)
+		{
+			x = y;
+			i -= mid + 1;
+		}
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::erase(iterator pos) -> iterator
+	{
+		node* x = pos.nd;
+		size_type i = pos.pos;
+		const bool internal = !x->leaf;
+		if (internal)    // 内部节点：用前驱替换被删除的元素，转化为删除叶节点中的前驱
+		{
+			node* leaf = rightmost_leaf(x->child(i));
+			destroy(x->value_ptr(i));
+			move_value(x, i, leaf, leaf->count - 1);
+			x = leaf;
+			i = leaf->count - 1;
+		}
+		else
+		{
+			destroy(x->value_ptr(i));
+		}
+		for (size_type j = i + 1; j != x->count; ++j)
+			move_value(x, j - 1, x, j);
+		--x->count;
+		--node_count;
+
+		iterator it(x, i);    // 指向被删除位置的后面，rebalance时随元素一起移动
+		rebalance(x, it);
+		if (root == nullptr)
+			return end();
+		while (it.pos == it.nd->count && it.nd->parent != nullptr)
+		{
+			it.pos = it.nd->position;
+			it.nd = it.nd->parent;
+		}
+		if (it.pos == it.nd->count)
+			return end();
+		if (internal)      // 此时it指向换到原位置上的前驱，再前进一步才是被删除元素的下一个
+			++it;
+		return it;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::erase(iterator first, iterator last) -> iterator
+	{
+		if (first == begin() && last == end())
+		{
+			clear();
+			return end();
+		}
+		// 删除会移动元素，last会失效，所以先数出个数再逐个删除
+		size_type n = 0;
+		for (iterator it = first; it != last; ++it)
+			++n;
+		while (n-- != 0)
+			first = erase(first);
+		return first;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::erase(const key_type& k) -> size_type
+	{
+		size_type n = 0;
+		iterator it = lower_bound(k);
+		while (it != end() && !comp(k, get_key(*it)))
+		{
+			it = erase(it);
+			++n;
+		}
+		return n;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::rebalance(node* x, iterator& it)
+	{
+		while (x != root && x->count < min_count)
+		{
+			node* p = x->parent;
+			size_type pi = x->position;
+			if (pi != 0 && p->child(pi - 1)->count > min_count)            // 1：左兄弟有多余的元素
+			{
+				rotate_right(p, pi - 1, it);
+				return;
+			}
+			if (pi != p->count && p->child(pi + 1)->count > min_count)     // 2：右兄弟有多余的元素
+			{
+				rotate_left(p, pi);
+				return;
+			}
+			merge(p, pi != 0 ? pi - 1 : pi, it);                           // 3：与兄弟合并，父节点少一个元素
+			x = p;
+		}
+		if (x == root && x->count == 0)      // 根节点空了，树的高度减一
+		{
+			if (x->leaf)
+			{
+				free_node(x);
+				root = leftmost = rightmost = nullptr;
+				it = iterator();
+			}
+			else
+			{
+				root = x->child(0);
+				root->parent = nullptr;
+				root->position = 0;
+				free_node(x);
+			}
+		}
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::rotate_right(node* p, size_type k, iterator& it)
+	{
+		node* left = p->child(k);
+		node* right = p->child(k + 1);
+		for (size_type j = right->count; j != 0; --j)
+			move_value(right, j, right, j - 1);
+		move_value(right, 0, p, k);
+		move_value(p, k, left, left->count - 1);
+		if (!right->leaf)
+		{
+			for (size_type j = right->count + 1; j != 0; --j)
+				set_child(right, j, right->child(j - 1));
+			set_child(right, 0, left->child(left->count));
+		}
+		--left->count;
+		++right->count;
+		if (it.nd == right)
+			++it.pos;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::rotate_left(node* p, size_type k)
+	{
+		node* left = p->child(k);
+		node* right = p->child(k + 1);
+		move_value(left, left->count, p, k);
+		move_value(p, k, right, 0);
+		for (size_type j = 1; j != right->count; ++j)
+			move_value(right, j - 1, right, j);
+		if (!right->leaf)
+		{
+			set_child(left, left->count + 1, right->child(0));
+			for (size_type j = 1; j <= right->count; ++j)
+				set_child(right, j - 1, right->child(j));
+		}
+		++left->count;
+		--right->count;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::merge(node* p, size_type k, iterator& it)
+	{
+		node* left = p->child(k);
+		node* right = p->child(k + 1);
+		const size_type lc = left->count;
+		move_value(left, lc, p, k);
+		for (size_type j = 0; j != right->count; ++j)
+			move_value(left, lc + 1 + j, right, j);
+		if (!right->leaf)
+		{
+			for (size_type j = 0; j <= right->count; ++j)
+				set_child(left, lc + 1 + j, right->child(j));
+		}
+		left->count = static_cast<unsigned short>(lc + 1 + right->count);
+		if (it.nd == right)
+		{
+			it.nd = left;
+			it.pos += lc + 1;
+		}
+
+		for (size_type j = k + 1; j != p->count; ++j)   // 父节点中去掉values[k]和children[k + 1]
+		{
+			move_value(p, j - 1, p, j);
+			set_child(p, j, p->child(j + 1));
+		}
+		--p->count;
+		if (right == rightmost)
+			rightmost = left;
+		free_node(right);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	inline void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::move_value(node* dst, size_type j, node* src, size_type i)
+	{
+		move_construct(dst->value_ptr(j), src->value(i));
+		destroy(src->value_ptr(i));
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	bool btree<Key, Value, KeyOfValue, Compare, NodeBytes>::operator == (const self& x) const
+	{
+		if (node_count != x.node_count)
+			return false;
+		for (const_iterator i = begin(), j = x.begin(); i != end(); ++i, ++j)
+		{
+			if (!(*i == *j))
+				return false;
+		}
+		return true;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::height() const -> size_type
+	{
+		size_type h = 0;
+		for (node* x = root; x != nullptr; x = x->leaf ? nullptr : x->child(0))
+			++h;
+		return h;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::new_node(bool leaf) -> node*
+	{
+		node* x = leaf ? leaf_allocator::allocate() : internal_allocator::allocate();
+		x->parent = nullptr;
+		x->position = 0;
+		x->count = 0;
+		x->leaf = leaf;
+		return x;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::free_node(node* x)
+	{
+		if (x->leaf)
+			leaf_allocator::deallocate(x);
+		else
+			internal_allocator::deallocate(static_cast<internal_node*>(x));
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	auto btree<Key, Value, KeyOfValue, Compare, NodeBytes>::copy_tree(node* x, node* parent) -> node*
+	{
+		node* y = new_node(x->leaf);
+		y->parent = parent;
+		y->position = x->position;
+		for (size_type i = 0; i != x->count; ++i)
+			construct(y->value_ptr(i), x->value(i));
+		y->count = x->count;
+		if (!x->leaf)
+		{
+			for (size_type i = 0; i <= x->count; ++i)
+				y->child(i) = copy_tree(x->child(i), y);
+		}
+		return y;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+	void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::destroy_tree(node* x)
+	{
+		for (size_type i = 0; i != x->count; ++i)
+			destroy(x->value_ptr(i));
+		if (!x->leaf)
+		{
+			for (size_type i = 0; i <= x->count; ++i)
+				destroy_tree(x->child(i));
+		}
+		free_node(x);
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_BTREE_IMPL_H_
@@ -0,0 +1,384 @@
+#ifndef _CONCURRENT_SKIPLIST_IMPL_H_
+#define _CONCURRENT_SKIPLIST_IMPL_H_
+
+/*
+*    Author  @yyehl
+*/
+
+namespace TinySTL
+{
+	/*********************** class concurrent_skiplist *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	concurrent_skiplist<Key, Value, KeyOfValue, Compare>::concurrent_skiplist(const Compare& cmp)
+		: head(allocate_node(max_level)), comp(cmp), count(0), global_epoch(0)
+	{
+		for (int i = 0; i != 3; ++i)
+		{
+			retired[i].store(nullptr);
+			for (size_type j = 0; j != stripes; ++j)
+				active[i][j].n.store(0);
+		}
+		head->fully_linked.store(true);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	concurrent_skiplist<Key, Value, KeyOfValue, Compare>::~concurrent_skiplist()
+	{
+		clear();
+		::operator delete(head);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto concurrent_skiplist<Key, Value, KeyOfValue, Compare>::allocate_node(int height) -> node*
+	{   // next的实际长度为height，只构造value以外的成员
+		node* x = static_cast<node*>(::operator new(sizeof(node) + (height - 1) * sizeof(std::atomic<node*>)));
+		new (&x->marked) std::atomic<bool>(false);
+		new (&x->fully_linked) std::atomic<bool>(false);
+		new (&x->locked) std::atomic<bool>(false);
+		x->height = height;
+		x->retired_next = nullptr;
+		for (int i = 0; i != height; ++i)
+			new (&x->next[i]) std::atomic<node*>(nullptr);
+		return x;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto concurrent_skiplist<Key, Value, KeyOfValue, Compare>::create_node(const value_type& val, int height) -> node*
+	{
+		node* x = allocate_node(height);
+		construct(&x->value, val);
+		return x;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::destroy_node(node* x)
+	{
+		destroy(&x->value);
+		::operator delete(x);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::lock(node* x)
+	{
+		while (x->locked.exchange(true, std::memory_order_acquire))
+			std::this_thread::yield();
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	int concurrent_skiplist<Key, Value, KeyOfValue, Compare>::random_level()
+	{   // 每个线程一个xorshift生成器，每两位都为0时升一层，即概率1/4
+		thread_local unsigned int seed = 0;
+		if (seed == 0)
+			seed = static_cast<unsigned int>(reinterpret_cast<size_t>(&seed) >> 4) | 1u;
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		unsigned int r = seed;
+		int h = 1;
+		while (h < max_level && (r & 3u) == 0)
+		{
+			++h;
+			r >>= 2;
+		}
+		return h;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto concurrent_skiplist<Key, Value, KeyOfValue, Compare>::stripe_index() -> size_type
+	{   // 各线程第一次用到时依次分配一个分片
+		static std::atomic<size_type> next_stripe(0);
+		thread_local size_type s = next_stripe.fetch_add(1, std::memory_order_relaxed) % stripes;
+		return s;
+	}
+
+	/************************** epoch回收 ****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto concurrent_skiplist<Key, Value, KeyOfValue, Compare>::enter(size_type& s) const -> size_type
+	{   // 先在读到的epoch中登记，再确认epoch没有在这期间前进，否则撤销重来
+		s = stripe_index();
+		while (true)
+		{
+			size_type e = global_epoch.load();
+			active[e % 3][s].n.fetch_add(1);
+			if (global_epoch.load() == e)
+				return e;
+			active[e % 3][s].n.fetch_sub(1);
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::retire(node* x, size_type e)
+	{
+		std::atomic<node*>& list = retired[e % 3];
+		node* old = list.load(std::memory_order_relaxed);
+		do
+		{
+			x->retired_next = old;
+		} while (!list.compare_exchange_weak(old, x, std::memory_order_release, std::memory_order_relaxed));
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::try_reclaim()
+	{   // epoch从e前进到e + 1的条件是e - 1中的操作都已结束；此时e - 2中删除的节点（与e + 1共用一条链表）已无人能访问
+		if (!reclaim_lock.try_lock())
+			return;
+		size_type e = global_epoch.load();
+		stripe_counter* prev = active[(e + 2) % 3];
+		bool quiet = true;
+		for (size_type i = 0; i != stripes; ++i)
+		{
+			if (prev[i].n.load() != 0)
+			{
+				quiet = false;
+				break;
+			}
+		}
+		node* list = nullptr;
+		if (quiet)
+		{
+			list = retired[(e + 1) % 3].exchange(nullptr, std::memory_order_acquire);
+			global_epoch.store(e + 1);
+		}
+		reclaim_lock.unlock();
+		free_list(list);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::free_list(node* x)
+	{
+		while (x != nullptr)
+		{
+			node* next = x->retired_next;
+			destroy_node(x);
+			x = next;
+		}
+	}
+
+	/************************** 查找 ****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	int concurrent_skiplist<Key, Value, KeyOfValue, Compare>::find_node(const key_type& k, node** preds, node** succs) const
+	{
+		int found = -1;
+		node* pred = head;
+		for (int level = max_level - 1; level >= 0; --level)
+		{
+			node* curr = pred->next[level].load(std::memory_order_acquire);
+			while (curr != nullptr && comp(key(curr), k))
+			{
+				pred = curr;
+				curr = pred->next[level].load(std::memory_order_acquire);
+			}
+			if (found == -1 && curr != nullptr && !comp(k, key(curr)))
+				found = level;
+			preds[level] = pred;
+			succs[level] = curr;
+		}
+		return found;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto concurrent_skiplist<Key, Value, KeyOfValue, Compare>::first_not_less(const key_type& k) const -> node*
+	{
+		node* pred = head;
+		node* curr = nullptr;
+		for (int level = max_level - 1; level >= 0; --level)
+		{
+			curr = pred->next[level].load(std::memory_order_acquire);
+			while (curr != nullptr && comp(key(curr), k))
+			{
+				pred = curr;
+				curr = pred->next[level].load(std::memory_order_acquire);
+			}
+		}
+		return curr;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	template<class Func>
+	bool concurrent_skiplist<Key, Value, KeyOfValue, Compare>::visit(const key_type& k, Func f) const
+	{
+		epoch_guard guard(*this);
+		node* x = first_not_less(k);
+		if (x == nullptr || comp(k, key(x)) || !x->fully_linked.load(std::memory_order_acquire) || x->marked.load(std::memory_order_acquire))
+			return false;
+		f(x->value);
+		return true;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	bool concurrent_skiplist<Key, Value, KeyOfValue, Compare>::contains(const key_type& k) const
+	{
+		epoch_guard guard(*this);
+		node* x = first_not_less(k);
+		return x != nullptr && !comp(k, key(x)) && x->fully_linked.load(std::memory_order_acquire) && !x->marked.load(std::memory_order_acquire);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	template<class Func>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::for_each(Func f) const
+	{
+		epoch_guard guard(*this);
+		for (node* x = head->next[0].load(std::memory_order_acquire); x != nullptr; x = x->next[0].load(std::memory_order_acquire))
+		{
+			if (x->fully_linked.load(std::memory_order_acquire) && !x->marked.load(std::memory_order_acquire))
+				f(x->value);
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	template<class Func>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::for_each(const key_type& lo, const key_type& hi, Func f) const
+	{
+		epoch_guard guard(*this);
+		for (node* x = first_not_less(lo); x != nullptr && comp(key(x), hi); x = x->next[0].load(std::memory_order_acquire))
+		{
+			if (x->fully_linked.load(std::memory_order_acquire) && !x->marked.load(std::memory_order_acquire))
+				f(x->value);
+		}
+	}
+
+	/************************** 插入、删除 ****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::unlock_preds(node** preds, int highest)
+	{   // 同一个节点可能是好几层的前驱，只解锁一次
+		node* prev = nullptr;
+		for (int level = 0; level <= highest; ++level)
+		{
+			if (preds[level] != prev)
+			{
+				unlock(preds[level]);
+				prev = preds[level];
+			}
+		}
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	bool concurrent_skiplist<Key, Value, KeyOfValue, Compare>::insert_unique(const value_type& val)
+	{
+		const key_type& k = KeyOfValue()(val);
+		int height = random_level();
+		node* preds[max_level];
+		node* succs[max_level];
+		epoch_guard guard(*this);
+		while (true)
+		{
+			int found = find_node(k, preds, succs);
+			if (found != -1)
+			{
+				node* x = succs[found];
+				if (!x->marked.load(std::memory_order_acquire))
+				{   // 已存在：等它链接完成，保证返回之后一定能找到它
+					while (!x->fully_linked.load(std::memory_order_acquire))
+						std::this_thread::yield();
+					return false;
+				}
+				continue;    // 正在被删除，重试
+			}
+			// 自下而上锁住各层的前驱，所有线程都按键值从大到小的顺序加锁，不会死锁
+			int highest = -1;
+			node* prev = nullptr;
+			bool valid = true;
+			for (int level = 0; valid && level < height; ++level)
+			{
+				node* pred = preds[level];
+				node* succ = succs[level];
+				if (pred != prev)
+				{
+					lock(pred);
+					prev = pred;
+				}
+				highest = level;
+				valid = !pred->marked.load(std::memory_order_acquire)
+					&& (succ == nullptr || !succ->marked.load(std::memory_order_acquire))
+					&& pred->next[level].load(std::memory_order_acquire) == succ;
+			}
+			if (!valid)
+			{
+				unlock_preds(preds, highest);
+				continue;
+			}
+			node* x = create_node(val, height);
+			for (int level = 0; level < height; ++level)
+				x->next[level].store(succs[level], std::memory_order_relaxed);
+			for (int level = 0; level < height; ++level)
+				preds[level]->next[level].store(x, std::memory_order_release);
+			x->fully_linked.store(true, std::memory_order_release);
+			unlock_preds(preds, highest);
+			count.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto concurrent_skiplist<Key, Value, KeyOfValue, Compare>::erase(const key_type& k) -> size_type
+	{
+		node* preds[max_level];
+		node* succs[max_level];
+		node* victim = nullptr;
+		bool is_marked = false;
+		int height = -1;
+		{
+			epoch_guard guard(*this);
+			while (true)
+			{
+				int found = find_node(k, preds, succs);
+				if (!is_marked)
+				{   // 只删除已经链接完成、且在它的最高层被找到的节点（否则它还在插入过程中）
+					if (found == -1)
+						return 0;
+					victim = succs[found];
+					if (!victim->fully_linked.load(std::memory_order_acquire) || victim->height - 1 != found
+						|| victim->marked.load(std::memory_order_acquire))
+						return 0;
+					height = victim->height;
+					lock(victim);
+					if (victim->marked.load(std::memory_order_acquire))
+					{
+						unlock(victim);
+						return 0;
+					}
+					victim->marked.store(true, std::memory_order_release);    // 逻辑删除，此后find都看不到它
+					is_marked = true;
+				}
+				int highest = -1;
+				node* prev = nullptr;
+				bool valid = true;
+				for (int level = 0; valid && level < height; ++level)
+				{
+					node* pred = preds[level];
+					if (pred != prev)
+					{
+						lock(pred);
+						prev = pred;
+					}
+					highest = level;
+					valid = !pred->marked.load(std::memory_order_acquire) && pred->next[level].load(std::memory_order_acquire) == victim;
+				}
+				if (!valid)
+				{
+					unlock_preds(preds, highest);
+					continue;
+				}
+				for (int level = height - 1; level >= 0; --level)    // 物理删除，victim自己的next保持不变，正走在它上面的线程可以继续前进
+					preds[level]->next[level].store(victim->next[level].load(std::memory_order_relaxed), std::memory_order_release);
+				unlock(victim);
+				unlock_preds(preds, highest);
+				count.fetch_sub(1, std::memory_order_relaxed);
+				retire(victim, guard.epoch());
+				break;
+			}
+		}
+		try_reclaim();
+		return 1;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void concurrent_skiplist<Key, Value, KeyOfValue, Compare>::clear()
+	{   // 不能与其他操作同时进行
+		node* x = head->next[0].load();
+		while (x != nullptr)
+		{
+			node* next = x->next[0].load();
+			destroy_node(x);
+			x = next;
+		}
+		for (int level = 0; level != max_level; ++level)
+			head->next[level].store(nullptr);
+		for (int i = 0; i != 3; ++i)
+			free_list(retired[i].exchange(nullptr));
+		count.store(0);
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_CONCURRENT_SKIPLIST_IMPL_H_
@@ -0,0 +1,301 @@
+#ifndef _FLAT_HASHTABLE_IMPL_H_
+#define _FLAT_HASHTABLE_IMPL_H_
+
+/*
+*    Author  @yyehl
+*/
+
+namespace TinySTL
+{
+	/************************* class flat_hashtable **************************************/
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::flat_hashtable(const self& x)
+		: ctrl(nullptr), slots(nullptr), capacity(0), num_elems(0), growth_left(0), hash(x.hash), equals(x.equals), get_key(x.get_key)
+	{
+		if (x.num_elems == 0)
+			return;
+		init_ctrl(capacity_for(x.num_elems));
+		for (size_type i = 0; i != x.capacity; ++i)   // 目标表里没有墓碑，直接找第一个空位放入
+		{
+			if (x.ctrl[i] >= 0)
+			{
+				size_type h = hash_of(get_key(x.slots[i]));
+				size_type pos = find_first_non_full(h);
+				construct(slots + pos, x.slots[i]);
+				set_ctrl(pos, h2(h));
+				++num_elems;
+				--growth_left;
+			}
+		}
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::~flat_hashtable()
+	{
+		clear();
+		deallocate_all();
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::operator = (const self& x) -> self&
+	{
+		if (this != &x)
+		{
+			self tmp(x);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::swap(self& x)
+	{
+		TinySTL::swap(ctrl, x.ctrl);
+		TinySTL::swap(slots, x.slots);
+		TinySTL::swap(capacity, x.capacity);
+		TinySTL::swap(num_elems, x.num_elems);
+		TinySTL::swap(growth_left, x.growth_left);
+		TinySTL::swap(hash, x.hash);
+		TinySTL::swap(equals, x.equals);
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::capacity_for(size_type n) -> size_type
+	{
+		size_type cap = min_capacity;
+		while (growth_of(cap) < n)
+			cap = cap * 2 + 1;
+		return cap;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::init_ctrl(size_type cap)
+	{
+		ctrl = ctrl_allocator::allocate(cap + group_width);
+		slots = slot_allocator::allocate(cap);
+		capacity = cap;
+		for (size_type i = 0; i != cap + group_width; ++i)
+			ctrl[i] = ctrl_empty;
+		ctrl[cap] = ctrl_sentinel;
+		growth_left = growth_of(cap);
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::deallocate_all()
+	{
+		if (ctrl != nullptr)
+		{
+			ctrl_allocator::deallocate(ctrl, capacity + group_width);
+			slot_allocator::deallocate(slots, capacity);
+		}
+		ctrl = nullptr;
+		slots = nullptr;
+		capacity = 0;
+		growth_left = 0;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	inline void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::set_ctrl(size_type i, ctrl_t c)
+	{
+		ctrl[i] = c;
+		if (i < group_width - 1)          // ctrl[0]~ctrl[14]在sentinel之后还有一份拷贝
+			ctrl[capacity + 1 + i] = c;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::find_index(const key_type& key, size_type h) const -> size_type
+	{
+		if (capacity == 0)
+			return 0;
+		const ctrl_t tag = h2(h);
+		size_type offset = h1(h) & capacity;
+		size_type step = 0;
+		for (;;)    // 按group做二次探测，装载率不超过7/8，总能遇到empty而停止
+		{
+			flat_group g(ctrl + offset);
+			for (unsigned mask = g.match(tag); mask != 0; mask &= mask - 1)
+			{
+				size_type i = (offset + count_trailing_zeros(mask)) & capacity;
+				if (equals(get_key(slots[i]), key))
+					return i;
+			}
+			if (g.match_empty() != 0)
+				return capacity;
+			step += group_width;
+			offset = (offset + step) & capacity;
+		}
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::find_first_non_full(size_type h) const -> size_type
+	{
+		size_type offset = h1(h) & capacity;
+		size_type step = 0;
+		for (;;)
+		{
+			unsigned mask = flat_group(ctrl + offset).match_empty_or_deleted();
+			if (mask != 0)
+				return (offset + count_trailing_zeros(mask)) & capacity;
+			step += group_width;
+			offset = (offset + step) & capacity;
+		}
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::find(const key_type& key) -> iterator
+	{
+		size_type i = find_index(key, hash_of(key));
+		return iterator(ctrl + i, slots + i);     // 找不到时i == capacity，正好是end()
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::find(const key_type& key) const -> const_iterator
+	{
+		size_type i = find_index(key, hash_of(key));
+		return const_iterator(ctrl + i, slots + i);
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::prepare_insert(size_type h) -> size_type
+	{
+		if (capacity == 0)
+			init_ctrl(min_capacity);
+		size_type i = find_first_non_full(h);
+		if (growth_left == 0 && ctrl[i] != ctrl_deleted)   // 占用墓碑不改变empty的个数，不需要重建
+		{
+			rehash_and_grow();
+			i = find_first_non_full(h);
+		}
+		return i;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::insert_unique(const value_type& val) -> pair<iterator, bool>
+	{
+		const key_type& key = get_key(val);
+		size_type h = hash_of(key);
+		size_type i = find_index(key, h);
+		if (i != capacity)
+			return pair<iterator, bool>(iterator(ctrl + i, slots + i), false);
+		i = prepare_insert(h);
+		construct(slots + i, val);     // 先构造元素，构造失败时表保持不变
+		if (ctrl[i] == ctrl_empty)
+			--growth_left;
+		set_ctrl(i, h2(h));
+		++num_elems;
+		return pair<iterator, bool>(iterator(ctrl + i, slots + i), true);
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::erase_at(size_type i)
+	{
+		destroy(slots + i);
+		--num_elems;
+		// 如果i前后的empty离得足够近，说明包含i的任何一个group都没有满过，
+		// 没有哪次探测因为i有元素而越过这里，可以直接置为empty；否则只能留下墓碑
+		size_type before = (i - group_width) & capacity;
+		unsigned empty_after = flat_group(ctrl + i).match_empty();
+		unsigned empty_before = flat_group(ctrl + before).match_empty();
+		bool was_never_full = empty_before != 0 && empty_after != 0 &&
+			count_trailing_zeros(empty_after) + (count_leading_zeros(empty_before) - 16) < group_width;
+		set_ctrl(i, was_never_full ? ctrl_empty : ctrl_deleted);
+		if (was_never_full)
+			++growth_left;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::erase(iterator pos)
+	{
+		erase_at(pos.ctrl - ctrl);
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	auto flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::erase(const key_type& key) -> size_type
+	{
+		size_type i = find_index(key, hash_of(key));
+		if (i == capacity)
+			return 0;
+		erase_at(i);
+		return 1;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::clear()
+	{
+		/* clear只析构元素，不回收ctrl和slots的空间 */
+		if (capacity == 0)
+			return;
+		for (size_type i = 0; i != capacity; ++i)
+		{
+			if (ctrl[i] >= 0)
+				destroy(slots + i);
+		}
+		for (size_type i = 0; i != capacity + group_width; ++i)
+			ctrl[i] = ctrl_empty;
+		ctrl[capacity] = ctrl_sentinel;
+		num_elems = 0;
+		growth_left = growth_of(capacity);
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::rehash_and_grow()
+	{
+		// 墓碑占了一半以上时按原大小重建就能腾出空间，否则capacity翻倍
+		if (num_elems * 2 <= growth_of(capacity))
+			rehash(capacity);
+		else
+			rehash(capacity * 2 + 1);
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::rehash(size_type new_capacity)
+	{
+		ctrl_t* old_ctrl = ctrl;
+		value_type* old_slots = slots;
+		size_type old_capacity = capacity;
+
+		init_ctrl(new_capacity);
+		for (size_type i = 0; i != old_capacity; ++i)
+		{
+			if (old_ctrl[i] >= 0)
+			{
+				size_type h = hash_of(get_key(old_slots[i]));
+				size_type pos = find_first_non_full(h);
+				construct(slots + pos, old_slots[i]);
+				set_ctrl(pos, h2(h));
+				destroy(old_slots + i);
+			}
+		}
+		growth_left -= num_elems;
+		if (old_ctrl != nullptr)
+		{
+			ctrl_allocator::deallocate(old_ctrl, old_capacity + group_width);
+			slot_allocator::deallocate(old_slots, old_capacity);
+		}
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	void flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::reserve(size_type n)
+	{
+		if (n <= num_elems + growth_left)
+			return;
+		rehash(capacity_for(n));
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	bool flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::operator == (const self& x) const
+	{
+		// 两个表的capacity、插入顺序可能不同，逐个元素到对方表中查找
+		if (num_elems != x.num_elems)
+			return false;
+		for (const_iterator it = begin(); it != end(); ++it)
+		{
+			const_iterator pos = x.find(get_key(*it));
+			if (pos == x.end() || !(*pos == *it))
+				return false;
+		}
+		return true;
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_FLAT_HASHTABLE_IMPL_H_
@@ -0,0 +1,76 @@
+#ifndef _FLAT_TREE_IMPL_H_
+#define _FLAT_TREE_IMPL_H_
+
+/*
+*    Author  @yyehl
+*/
+
+namespace TinySTL
+{
+	/************************* class flat_tree **************************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto flat_tree<Key, Value, KeyOfValue, Compare>::insert_unique(const value_type& val) -> pair<iterator, bool>
+	{
+		const key_type& key = KeyOfValue()(val);
+		iterator it = lower_bound(key);
+		if (it != end() && !comp(key, KeyOfValue()(*it)))    // 已经存在
+			return pair<iterator, bool>(it, false);
+		if (it == end())       // 按顺序插入时总是在末尾，不需要移动元素
+		{
+			c.push_back(val);
+			return pair<iterator, bool>(end() - 1, true);
+		}
+		return pair<iterator, bool>(c.insert(it, val), true);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	template<class InputIterator>
+	void flat_tree<Key, Value, KeyOfValue, Compare>::insert_unique(InputIterator first, InputIterator last)
+	{
+		const size_type n = c.size();
+		for (; first != last; ++first)
+			c.push_back(*first);
+		if (c.size() == n)
+			return;
+		value_less less(comp);
+		TinySTL::sort(c.begin() + n, c.end(), less);
+
+		if (n == 0 || less(c[n - 1], c[n]))    // 1：新元素都在原有元素的后面，只需要在新的一段中去掉重复的
+		{
+			iterator result = c.begin() + n;
+			for (iterator it = result + 1; it != c.end(); ++it)
+			{
+				if (less(*result, *it))
+					*++result = *it;
+			}
+			c.erase(result + 1, c.end());
+			return;
+		}
+
+		// 2：与原有的元素合并到新的数组中，key相同时保留原有的元素，新元素中重复的只保留一个
+		container_type tmp;
+		tmp.reserve(c.size());
+		iterator i = c.begin(), mid = c.begin() + n, j = mid;
+		while (i != mid || j != c.end())
+		{
+			const value_type& x = (j == c.end() || (i != mid && !less(*j, *i))) ? *i++ : *j++;
+			if (tmp.empty() || less(tmp.back(), x))
+				tmp.push_back(x);
+		}
+		c.swap(tmp);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto flat_tree<Key, Value, KeyOfValue, Compare>::erase(const key_type& key) -> size_type
+	{
+		iterator it = find(key);
+		if (it == end())
+			return 0;
+		c.erase(it);
+		return 1;
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_FLAT_TREE_IMPL_H_
@@ -0,0 +1,167 @@
+/*
+*	Author @yyehl
+*/
+
+#include "../Hash_index.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace TinySTL
+{
+	namespace
+	{
+		bool sync_file(FILE* fp)      // 把已经fflush的内容刷到磁盘上
+		{
+#ifdef _WIN32
+			return _commit(_fileno(fp)) == 0;
+#else
+			return fsync(fileno(fp)) == 0;
+#endif
+		}
+		bool replace_file(const char* from, const char* to)   // 用from原子地替换to
+		{
+#ifdef _WIN32
+			return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+			return rename(from, to) == 0;
+#endif
+		}
+	}
+
+	bool hash_index_valid(const void* data, size_t size, size_t key_size, size_t value_size, size_t slot_size)
+	{
+		if (data == nullptr || size < sizeof(hash_index_header))
+			return false;
+		hash_index_header header;
+		memcpy(&header, data, sizeof(header));
+		if (memcmp(header.magic, "TSHIDX1", 8) != 0 || header.endian != hash_index_endian)
+			return false;
+		if (header.key_size != key_size || header.value_size != value_size || header.slot_size != slot_size)
+			return false;
+		const unsigned long long cap = header.capacity;
+		if (cap == 0 || (cap & (cap - 1)) != 0 || header.count >= cap)   // 写入时至少留一个空位；ctrl本身不检查，find另外限制了探测次数
+			return false;
+		// 以下检查各部分都在文件范围之内，先比较再相乘，防止溢出
+		if (header.file_size > size)
+			return false;
+		if (header.ctrl_offset < sizeof(hash_index_header) || header.ctrl_offset > header.file_size
+			|| cap > header.file_size - header.ctrl_offset)
+			return false;
+		if (header.slots_offset % 64 != 0 || header.slots_offset > header.file_size
+			|| cap > (header.file_size - header.slots_offset) / slot_size)
+			return false;
+		return true;
+	}
+
+	bool hash_index_write_file(const char* path, const void* data, size_t size)
+	{   // path可能正被别的进程映射着，直接以"wb"打开会把它截断，读者再访问映射区就会出错（SIGBUS）
+		// 所以先完整地写到path.tmp并刷到磁盘，再改名覆盖path：读者要么看到旧文件，要么看到新文件
+		const size_t n = strlen(path);
+		char* tmp = allocator<char>::allocate(n + 5);
+		memcpy(tmp, path, n);
+		memcpy(tmp + n, ".tmp", 5);
+		bool ok = false;
+		FILE* fp = fopen(tmp, "wb");
+		if (fp != nullptr)
+		{
+			ok = fwrite(data, 1, size, fp) == size && fflush(fp) == 0 && sync_file(fp);
+			ok = (fclose(fp) == 0) && ok;
+			ok = ok && replace_file(tmp, path);
+			if (!ok)
+				remove(tmp);
+		}
+		allocator<char>::deallocate(tmp, n + 5);
+		return ok;
+	}
+
+	/*********************** class mapped_file *****************************/
+#ifdef _WIN32
+	mapped_file::mapped_file() : addr(nullptr), len(0), file_handle(nullptr), map_handle(nullptr) { }
+
+	bool mapped_file::open(const char* path)
+	{
+		close();
+		HANDLE fh = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (fh == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER sz;
+		if (!GetFileSizeEx(fh, &sz) || sz.QuadPart == 0)   // 空文件不能映射
+		{
+			CloseHandle(fh);
+			return false;
+		}
+		HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mh == nullptr)
+		{
+			CloseHandle(fh);
+			return false;
+		}
+		const void* p = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+		if (p == nullptr)
+		{
+			CloseHandle(mh);
+			CloseHandle(fh);
+			return false;
+		}
+		file_handle = fh;
+		map_handle = mh;
+		addr = p;
+		len = static_cast<size_t>(sz.QuadPart);
+		return true;
+	}
+
+	void mapped_file::close()
+	{
+		if (addr != nullptr)
+			UnmapViewOfFile(addr);
+		if (map_handle != nullptr)
+			CloseHandle(map_handle);
+		if (file_handle != nullptr)
+			CloseHandle(file_handle);
+		addr = nullptr;
+		len = 0;
+		file_handle = map_handle = nullptr;
+	}
+#else
+	mapped_file::mapped_file() : addr(nullptr), len(0) { }
+
+	bool mapped_file::open(const char* path)
+	{
+		close();
+		int fd = ::open(path, O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)   // 空文件不能mmap
+		{
+			::close(fd);
+			return false;
+		}
+		void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);              // 映射建立之后就不再需要fd了
+		if (p == MAP_FAILED)
+			return false;
+		addr = p;
+		len = static_cast<size_t>(st.st_size);
+		return true;
+	}
+
+	void mapped_file::close()
+	{
+		if (addr != nullptr)
+			munmap(const_cast<void*>(addr), len);
+		addr = nullptr;
+		len = 0;
+	}
+#endif
+
+}  // namespace TinySTL
@@ -8,29 +8,25 @@
 namespace TinySTL
 {
 	/****************************** strcut hashtable_iterator ****************************************/
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::operator ++ () -> iterator&
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::operator ++ () -> iterator&
 	{
-		hashtable_node* old = cur;
+		node* old = cur;
 		cur = cur->next;
 		if (cur == nullptr)
-		{
-			size_type bucket = ht->bkt_num(old->val);  // ԭbucketֵ
-			while (cur == nullptr && ++bucket < ht.buckets.size())
-				cur = ht->buckets[bucket];
-		}
+			cur = ht->next_node(old);   // 渐进式rehash期间old可能在old_buckets中，交给hashtable判断
 		return *this;
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::operator ++ (int)->iterator
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::operator ++ (int)->iterator
 	{
 		iterator tmp = *this;
 		++*this;
 		return tmp;
 	}
 
-	/************************* class hashtable **************************************/
-	
+	/****************************** rehash policy ****************************************/
+	// 以下为28个质数，用于给buckets定义大小
 	const int buckets_prime_nums = 28;
 	const unsigned long buckets_num_list[buckets_prime_nums] =
 	{
@@ -40,136 +36,309 @@ namespace TinySTL
 		4294967291ul
 	};
 
-
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	inline unsigned long hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::next_prime_num(size_type n)
+	// 返回buckets_num_list中不小于n的第一个质数
+	inline size_t prime_rehash_policy::next_bkt(size_t n)
 	{
 		const unsigned long* first = buckets_num_list;
 		const unsigned long* last = first + buckets_prime_nums;
 		const unsigned long* pos = first;
-		while (*pos < n && pos != last)
+		while (pos != last && *pos < n)
 			++pos;
 		return (pos == last) ? *(last - 1) : *pos;
 	}
+	inline size_t prime_rehash_policy::max_bkt_count()
+	{
+		return buckets_num_list[buckets_prime_nums - 1];
+	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::new_node() -> node*
+	/************************* class hashtable **************************************/
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::new_node(const value_type& val, size_type code) -> node*
 	{
 		node* ret = node_allocator::allocate();
 		ret->next = nullptr;
-		construct(&(ret->val), value_type());
+		set_code(ret, code, cache_tag());
+		construct(&(ret->val), val);
 		return ret;
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::destroy_node(node* ptr)
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::destroy_node(node* ptr)
 	{
 		destroy(&(ptr->val));
-		node_allocator::deallocate(ptr);
+		if (arena != nullptr && ptr >= arena && ptr < arena + arena_size)   // arena中的节点不单独释放
+		{
+			if (--arena_live == 0)
+				release_arena();
+		}
+		else
+		{
+			node_allocator::deallocate(ptr);
+		}
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::init_buckets(size_type n)
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::release_arena()
 	{
-		const size_type buckets_size = next_prime_num(n);
-		buckets.reserve(bucket_size);
-		buckets.insert(buckets.end(), buckets.size, (node*)nullptr);
+		node_allocator::deallocate(arena, arena_size);
+		arena = nullptr;
+		arena_size = 0;
+		arena_live = 0;
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::init_buckets(size_type n)
+	{
+		const size_type buckets_size = rehash_policy::next_bkt(n);
+		buckets.reserve(buckets_size);
+		buckets.insert(buckets.end(), buckets_size, (node*)nullptr);
 		num_elems = 0;
+		update_next_resize();
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::insert_unique(const value_type& val)->pair<iterator, bool>
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_unique(const value_type& val)->pair<iterator, bool>
+	{
+		return insert_unique(val, hash(get_key(val)));
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_equal(const value_type& val)->iterator
 	{
-		resize(num_elems + 1);  
-		return insert_unique_noresize(val);
+		return insert_equal(val, hash(get_key(val)));
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::insert_equal(const value_type& val)->iterator
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_unique(const value_type& val, size_type code)->pair<iterator, bool>
 	{
 		resize(num_elems + 1);
-		return insert_equal_noresize(val);
+		if (is_rehashing())
+		{
+			migrate_code(code);
+			migrate_buckets(rehash_batch);
+		}
+		return insert_unique_noresize(val, code);
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_equal(const value_type& val, size_type code)->iterator
+	{
+		resize(num_elems + 1);
+		if (is_rehashing())
+		{
+			migrate_code(code);   // 相同key的元素都在同一个数组里，insert_equal才能把它们放在一起
+			migrate_buckets(rehash_batch);
+		}
+		return insert_equal_noresize(val, code);
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class InputIterator>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_unique_range(InputIterator first, InputIterator last, input_iterator_tag)
+	{
+		for (; first != last; ++first)     // 不知道元素个数，只能逐个插入
+			insert_unique(*first);
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class ForwardIterator>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_unique_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+	{
+		resize(num_elems + range_length(first, last));   // 有重复元素时buckets会略多一些
+		finish_rehash();     // 一次插入很多元素，渐进式rehash没有意义，直接搬完
+		for (; first != last; ++first)
+			insert_unique_noresize(*first, hash(get_key(*first)));
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class InputIterator>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_equal_range(InputIterator first, InputIterator last, input_iterator_tag)
+	{
+		for (; first != last; ++first)
+			insert_equal(*first);
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class ForwardIterator>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_equal_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+	{
+		resize(num_elems + range_length(first, last));
+		finish_rehash();
+		for (; first != last; ++first)
+			insert_equal_noresize(*first, hash(get_key(*first)));
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::resize(size_type n)
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class ForwardIterator>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::range_length(ForwardIterator first, ForwardIterator last) -> size_type
 	{
-		// 判断标准，当元素的数量大于buckets的数量（即vector的大小）时，就重建vector
+		size_type n = 0;
+		for (; first != last; ++first)
+			++n;
+		return n;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::resize(size_type n)
+	{
+		// 判断标准，当元素的数量大于buckets的数量 * max_load（默认为1）时，就重建vector
 		// 所以元素个数的最大值也就等于buckets的数量，可以基本保证开链长度不过长影响性能
+		if (n <= next_resize)
+			return;
+		finish_rehash();     // 上一次渐进式rehash还没有完成时，先把它完成
 		const size_type old_n = buckets.size(); // 原buckets的大小
-		if (n > old_n)     // 如果新的元素数量n比原buckets的size要大
-			const size_type new_n = next_prime_num(n);  //则寻找新的下一个质数
-		if (new_n > old_n)   // 如果新的质数比原来的大（当old_n已经是最大的质数了，那么new_n会等于old_n）
-		{ 
-			vector<node*> tmp(new_n, nullptr); // 新的vector
-			for (size_type bucket = 0; bucket < old_n; ++bucket) // 循环处理原buckets的元素
+		const size_type new_n = rehash_policy::next_bkt(bkt_for(n));  //则寻找新的buckets个数
+		if (new_n > old_n)   // 如果新的个数比原来的大（当old_n已经是最大值了，那么new_n会等于old_n）
+		{
+			if (incremental)   // 渐进式：只换上新的buckets，节点留在old_buckets中，之后慢慢搬
 			{
-				node* first = buckets[bucket];
-				size_type new_bucket = bkt_num(first->val, new_n);
+				vector<node*> tmp(new_n, (node*)nullptr); // 新的vector
+				old_buckets.swap(buckets);
+				buckets.swap(tmp);
+				migrate_pos = 0;
+				update_next_resize();
+				return;
+			}
+			rebuild_buckets(new_n);
+		}
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::rebuild_buckets(size_type new_n)
+	{
+		const size_type old_n = buckets.size();
+		vector<node*> tmp(new_n, (node*)nullptr); // 新的vector
+		for (size_type bucket = 0; bucket < old_n; ++bucket) // 循环处理原buckets的元素
+		{
+			node* first = buckets[bucket];
+			while (first != nullptr)
+			{
+				size_type new_bucket = node_bkt(first, new_n);
 				buckets[bucket] = first->next;
 				first->next = tmp[new_bucket]; // 令将要插入进来的节点的next指向原本开链的头结点，才能连起来
 				tmp[new_bucket] = first;
 				first = buckets[bucket];
 			}
-			buckets.swap(tmp);  // vector的swap函数
-			// 离开时 将会释放tmp的内存
 		}
+		buckets.swap(tmp);  // vector的swap函数
+		// 离开时 将会释放tmp的内存
+		update_next_resize();
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::rehash(size_type n)
+	{
+		finish_rehash();
+		const size_type need = bkt_for(num_elems);   // 不能小于当前元素个数所需要的buckets个数
+		const size_type new_n = rehash_policy::next_bkt(n < need ? need : n);
+		if (new_n != buckets.size())
+			rebuild_buckets(new_n);
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::max_load_factor(float z)
+	{   // z <= 0和NaN没有意义，忽略，保持原来的值；过小、过大（包括无穷大）的值限制在[1/64, 1024]之间，
+		// 否则bkt_for中的n / max_load、update_next_resize中的buckets.size() * max_load转换成size_type时会溢出
+		if (!(z > 0))
+			return;
+		max_load = z < 1.0f / 64 ? 1.0f / 64 : (z > 1024 ? 1024.0f : z);
+		update_next_resize();
+		resize(num_elems);     // 变小之后当前的buckets可能已经不够
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::compact()
+	{
+		shrink_to_fit();
+		if (num_elems == 0)
+			return;
+		node* old_arena = arena;          // 旧arena中的节点在下面的循环中全部析构，最后整块释放
+		const size_type old_arena_size = arena_size;
+		arena = nullptr;
+		arena_size = arena_live = 0;
+		node* new_arena = node_allocator::allocate(num_elems);
+		size_type used = 0;
+		for (size_type i = 0; i != buckets.size(); ++i)
+		{
+			node** link = &buckets[i];
+			for (node* cur = buckets[i]; cur != nullptr; )
+			{
+				node* next = cur->next;
+				node* copy = new_arena + used++;
+				copy->next = nullptr;
+				set_code(copy, node_code(cur), cache_tag());
+				construct(&(copy->val), cur->val);
+				*link = copy;
+				link = &copy->next;
+				if (old_arena != nullptr && cur >= old_arena && cur < old_arena + old_arena_size)
+					destroy(&(cur->val));
+				else
+					destroy_node(cur);
+				cur = next;
+			}
+		}
+		if (old_arena != nullptr)
+			node_allocator::deallocate(old_arena, old_arena_size);
+		arena = new_arena;
+		arena_size = arena_live = num_elems;
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::insert_unique_noresize(const value_type& val)
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_unique_noresize(const value_type& val, size_type code)
 		->pair<iterator, bool>
 	{
-		size_type n = bkt_num(val, buckets_count());
+		size_type n = bkt_num_code(code, buckets.size());
 		node* first = buckets[n];
-		for (node* cur = first; cur != nullptr; ++cur)
+		for (node* cur = first; cur != nullptr; cur = cur->next)
 		{
-			if (equals(get_key(val), get_key(cur->val)))
-				return pair<iterator, bool>(iterator(cur, this), bool);
+			if (code_match(cur, code) && equals(get_key(val), get_key(cur->val)))
+				return pair<iterator, bool>(iterator(cur, this), false);
 		}
-		node* tmp = new_node();
-		tmp->val = val;
+		node* tmp = new_node(val, code);
 		tmp->next = first;
 		buckets[n] = tmp;
 		++num_elems;
 		return pair<iterator, bool>(iterator(tmp, this), true);
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::insert_equal_noresize(const value_type& val)->iterator
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::insert_equal_noresize(const value_type& val, size_type code)->iterator
 	{
-		size_type n = bkt_num(val, buckets_count());
+		size_type n = bkt_num_code(code, buckets.size());
 		node* first = buckets[n];
-		for (node* cur = first; cur != nullptr; ++cur)
+		for (node* cur = first; cur != nullptr; cur = cur->next)
 		{
-			if (equals(get_key(val), get_key(cur->val)))
+			if (code_match(cur, code) && equals(get_key(val), get_key(cur->val)))
 			{
-				node* tmp = new_node();
-				tmp->val = val;
+				node* tmp = new_node(val, code);
 				tmp->next = cur->next;
 				cur->next = tmp;
 				++num_elems;
 				return iterator(tmp, this);
 			}
 		}
-		node* tmp = new_node();
-		tmp->val = val;
+		node* tmp = new_node(val, code);
 		tmp->next = first;
 		buckets[n] = tmp;
 		++num_elems;
 		return iterator(tmp, this);
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::erase(iterator pos)
-	{
-		size_type n = bkt_num(*pos, buckets_count());
-		node* cur = buckets[n];
-		while (cur->next != pos.cur)   // cur is pos.cur's parent
-			++cur;
-		cur->next = pos.cur->next;
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::erase(iterator pos, size_type code)
+	{
+		if (!unlink_node(buckets, bkt_num_code(code, buckets.size()), pos.cur))
+			unlink_node(old_buckets, bkt_num_code(code, old_buckets.size()), pos.cur);   // 还没有搬到新buckets中
 		destroy_node(pos.cur);
 		--num_elems;
+		if (is_rehashing())
+			migrate_buckets(rehash_batch);
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::clear()
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	bool hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::unlink_node(vector<node*>& bkts, size_type n, node* x)
+	{
+		node* cur = bkts[n];
+		if (cur == x)     // x 是开链的头结点
+		{
+			bkts[n] = cur->next;
+			return true;
+		}
+		while (cur != nullptr && cur->next != x)   // cur is x's parent
+			cur = cur->next;
+		if (cur == nullptr)
+			return false;
+		cur->next = x->next;
+		return true;
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::clear()
 	{
 		/* clear只清除开链，不回收buckets(vector) 的空间 */
+		finish_rehash();    // 节点都搬到buckets中再统一释放
 		for (size_type i = 0; i != buckets.size(); ++i)
 		{
 			node* cur = buckets[i];
@@ -181,68 +350,123 @@ namespace TinySTL
 			}
 			buckets[i] = nullptr;   // 将buckets的指针都置为nulltpr
 		}
-		num_elems = 0;  
+		num_elems = 0;      // 此时arena中的节点已经全部删除，arena也已经释放
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::copy_from(const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& ht)
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::copy_from(const self& ht)
 	{
+		clear();
 		buckets.clear();
-		buckets.reserve(ht.buckets_count.size());
-		buckets.insert(buckets.begin(), buckets.end(), nullptr);
+		buckets.reserve(ht.buckets_count());
+		buckets.insert(buckets.end(), ht.buckets_count(), (node*)nullptr);
 		for (size_type i = 0; i < ht.buckets_count(); ++i)
 		{
 			if (const node* cur = ht.buckets[i])  // 当不为nullptr时才执行
 			{
-				node* copy = new_node();
-				copy->val = cur->val;
+				node* copy = new_node(cur->val, ht.node_code(cur));
 				buckets[i] = copy;
 
-				for (node* next = cur->next; next != nullptr; cur = next, next = cur->next)
+				for (const node* next = cur->next; next != nullptr; cur = next, next = cur->next)
 				{
-					copy->next = new_node();
-					copy->val = next->val;
+					copy->next = new_node(next->val, ht.node_code(next));
 					copy = copy->next;
 				}
 			}
 		}
+		// ht正在渐进式rehash时，还在old_buckets中的节点直接放进新的buckets，拷贝出来的表不处于rehash状态
+		for (size_type i = ht.migrate_pos; i < ht.old_buckets.size(); ++i)
+		{
+			for (const node* cur = ht.old_buckets[i]; cur != nullptr; cur = cur->next)
+			{
+				const size_type code = ht.node_code(cur);
+				const size_type n = bkt_num_code(code, buckets.size());
+				node* copy = new_node(cur->val, code);
+				copy->next = buckets[n];
+				buckets[n] = copy;
+			}
+		}
 		num_elems = ht.num_elems;
+		update_next_resize();
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::swap(hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x)
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::swap(self& x)
 	{
+		TinySTL::swap(hash, x.hash);
+		TinySTL::swap(equals, x.equals);
 		buckets.swap(x.buckets);
-		swap(num_elems, x.num_elems);
+		TinySTL::swap(num_elems, x.num_elems);
+		old_buckets.swap(x.old_buckets);
+		TinySTL::swap(migrate_pos, x.migrate_pos);
+		TinySTL::swap(incremental, x.incremental);
+		TinySTL::swap(max_load, x.max_load);
+		TinySTL::swap(next_resize, x.next_resize);
+		TinySTL::swap(arena, x.arena);
+		TinySTL::swap(arena_size, x.arena_size);
+		TinySTL::swap(arena_live, x.arena_live);
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::find(const key_type& key)  -> iterator
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class ForwardIterator, class OutputIterator>
+	OutputIterator hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::find_batch(ForwardIterator first, ForwardIterator last,
+		OutputIterator result) const
 	{
-		size_type n = bkt_num_key(key);
-		node* first = buckets[n];
-		while (first != nullptr && !equals(key, first->val))
-			first = first->next;
-		if (first != nullptr)
-			return iterator(first, this);
-		else
-			return end();
+		const key_type* keys[batch_size];
+		size_type codes[batch_size];
+		size_type bkts[batch_size];
+		node* heads[batch_size];
+		while (first != last)
+		{
+			size_type cnt = 0;
+			for (; cnt != batch_size && first != last; ++first, ++cnt)   // 第一遍：算hash，预取bucket
+			{
+				keys[cnt] = &*first;
+				codes[cnt] = hash(*first);
+				bkts[cnt] = bkt_num_code(codes[cnt], buckets.size());
+				prefetch_read(&buckets[bkts[cnt]]);
+			}
+			for (size_type i = 0; i != cnt; ++i)     // 第二遍：读出开链的头节点，预取节点
+			{
+				heads[i] = buckets[bkts[i]];
+				if (heads[i] != nullptr)
+					prefetch_read(heads[i]);
+			}
+			for (size_type i = 0; i != cnt; ++i)     // 第三遍：比较key
+			{
+				node* cur = heads[i];
+				while (cur != nullptr && !(code_match(cur, codes[i]) && equals(*keys[i], get_key(cur->val))))
+					cur = cur->next;
+				if (cur == nullptr && is_rehashing())   // 可能还在old_buckets中
+					cur = find_node(*keys[i], codes[i]);
+				*result = iterator(cur, const_cast<self*>(this));
+				++result;
+			}
+		}
+		return result;
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::count(const key_type& key) const ->size_type
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class K>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::count_key(const K& key, size_type code) const ->size_type
 	{
-		const size_type n = bkt_num_key(key);
+		const size_type n = bkt_num_code(code, buckets.size());
 		size_type ret = 0;
 		node* first = buckets[n];
 		for (node* cur = first; cur != nullptr; cur = cur->next)
-			if (equals(key, get_key(cur->val)))
+			if (code_match(cur, code) && equals(key, get_key(cur->val)))
 				++ret;
+		if (is_rehashing())
+		{
+			for (node* cur = old_buckets[bkt_num_code(code, old_buckets.size())]; cur != nullptr; cur = cur->next)
+				if (code_match(cur, code) && equals(key, get_key(cur->val)))
+					++ret;
+		}
 		return ret;
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::begin() -> iterator
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::begin() const -> iterator
 	{
 		node* ret = nullptr;
-		for (int i = 0; i < buckets_count(); ++i)
+		for (size_type i = 0; i < buckets_count(); ++i)
 		{
 			if (buckets[i] != nullptr)
 			{
@@ -250,77 +474,169 @@ namespace TinySTL
 				break;
 			}
 		}
-		return iterator(ret, this);
-	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::end() -> iterator
-	{
-		node* end = buckets[buckets_count()];
-		while (end != nullptr)
-			end = end->next;
-		return iterator(end, this);
+		for (size_type i = migrate_pos; ret == nullptr && i < old_buckets.size(); ++i)
+			ret = old_buckets[i];
+		return iterator(ret, const_cast<self*>(this));
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	bool hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::operator== (const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x) const
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	bool hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::operator== (const self& x) const
 	{
-		if (num_elems != x.num_elems || buckets != x.buckets)
+		// 两个表的buckets个数、是否在rehash都可能不同，不能逐个bucket比较，改为按元素比较
+		if (num_elems != x.num_elems)
 			return false;
-		for (size_type i = 0; i < buckets.size(); ++i)
+		for (iterator it = begin(); it != end(); ++it)
 		{
-			node* p1 = buckets[i];
-			node* p2 = buckets[i];
-			while (p1->val == p2->val && p1 != nullptr && p2->nullptr)
-			{
-				p1 = p1->next;
-				p2 = p2->next;
-			}
-			if (!(p1 == nullptr && p2 == nullptr))
+			if (count_value(*it) != x.count_value(*it))
 				return false;
 		}
 		return true;
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	bool hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::operator!= (const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x) const
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	bool hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::operator!= (const self& x) const
 	{
 		return !(this->operator==(x));
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::~hashtable()
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::~hashtable()
 	{
 		clear();
-		buckets.clear();
-		buckets.shrink_to_fit();
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::operator = (const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x) -> self&
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::operator = (const self& x) -> self&
 	{
-		copy_from(x);
+		if (this != &x)
+		{
+			hash = x.hash;
+			equals = x.equals;
+			incremental = x.incremental;
+			max_load = x.max_load;
+			copy_from(x);
+		}
 		return *this;
 	}
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::bkt_num(const value_type& val, size_type n) -> size_type
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::bkt_num(const value_type& val, size_type n) const -> size_type
 	{
 		return bkt_num_key(get_key(val), n);
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::bkt_num(const value_type& val)->size_type
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::bkt_num(const value_type& val) const ->size_type
 	{
 		return bkt_num_key(get_key(val));
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::bkt_num_key(const key_type& key)->size_type
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::bkt_num_key(const key_type& key) const ->size_type
 	{
 		return bkt_num_key(key, buckets.size());
 	}
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
-	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>::bkt_num_key(const key_type& key, size_type n)->size_type
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::bkt_num_key(const key_type& key, size_type n) const ->size_type
+	{
+		return bkt_num_code(hash(key), n);
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	template<class K>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::find_node(const K& key, size_type code) const -> node*
+	{
+		node* first = buckets[bkt_num_code(code, buckets.size())];
+		while (first != nullptr && !(code_match(first, code) && equals(key, get_key(first->val))))
+			first = first->next;
+		if (first == nullptr && is_rehashing())
+		{
+			first = old_buckets[bkt_num_code(code, old_buckets.size())];   // 已经搬走的旧bucket为nullptr
+			while (first != nullptr && !(code_match(first, code) && equals(key, get_key(first->val))))
+				first = first->next;
+		}
+		return first;
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::count_value(const value_type& val) const -> size_type
+	{
+		size_type ret = 0;
+		for (node* cur = buckets[bkt_num(val)]; cur != nullptr; cur = cur->next)
+			if (cur->val == val)
+				++ret;
+		if (is_rehashing())
+		{
+			for (node* cur = old_buckets[bkt_num(val, old_buckets.size())]; cur != nullptr; cur = cur->next)
+				if (cur->val == val)
+					++ret;
+		}
+		return ret;
+	}
+
+	// 迭代顺序：先遍历buckets，再遍历old_buckets中还没有搬走的部分
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	auto hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::next_node(const node* x) const -> node*
+	{
+		size_type bucket = 0;
+		if (is_rehashing())
+		{
+			bucket = node_bkt(x, old_buckets.size());
+			const node* cur = old_buckets[bucket];
+			while (cur != nullptr && cur != x)
+				cur = cur->next;
+			if (cur != nullptr)     // x在old_buckets中，接着遍历后面的旧bucket
+			{
+				while (++bucket < old_buckets.size())
+					if (old_buckets[bucket] != nullptr)
+						return old_buckets[bucket];
+				return nullptr;
+			}
+		}
+		bucket = node_bkt(x, buckets.size());  // 原bucket值
+		while (++bucket < buckets.size())
+			if (buckets[bucket] != nullptr)
+				return buckets[bucket];
+		for (bucket = migrate_pos; bucket < old_buckets.size(); ++bucket)
+			if (old_buckets[bucket] != nullptr)
+				return old_buckets[bucket];
+		return nullptr;
+	}
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::migrate_bucket(size_type i)
+	{
+		node* first = old_buckets[i];
+		while (first != nullptr)
+		{
+			size_type new_bucket = node_bkt(first, buckets.size());
+			old_buckets[i] = first->next;
+			first->next = buckets[new_bucket];
+			buckets[new_bucket] = first;
+			first = old_buckets[i];
+		}
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::migrate_code(size_type code)
+	{
+		migrate_bucket(bkt_num_code(code, old_buckets.size()));
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::migrate_buckets(size_type count)
+	{
+		const size_type old_n = old_buckets.size();
+		const size_type last = (old_n - migrate_pos > count) ? migrate_pos + count : old_n;
+		for (; migrate_pos < last; ++migrate_pos)
+			migrate_bucket(migrate_pos);
+		if (migrate_pos == old_n)   // 全部搬完，释放旧的buckets
+		{
+			vector<node*> tmp;
+			old_buckets.swap(tmp);
+			migrate_pos = 0;
+		}
+	}
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	void hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>::finish_rehash()
 	{
-		return hash(key) % n;
+		if (is_rehashing())
+			migrate_buckets(old_buckets.size());
 	}
 
 }  // namespace STL
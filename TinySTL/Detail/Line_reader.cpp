@@ -0,0 +1,195 @@
+/*
+*	Author @yyehl
+*/
+
+#include "../Line_reader.h"
+#include <cstring>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace TinySTL
+{
+	static int open_read_only(const char* path)
+	{
+#ifdef _WIN32
+		return _open(path, _O_RDONLY | _O_BINARY);
+#else
+		return open(path, O_RDONLY);
+#endif
+	}
+	static void close_file(int fd)
+	{
+#ifdef _WIN32
+		_close(fd);
+#else
+		close(fd);
+#endif
+	}
+	static long read_file(int fd, char* p, size_t n)
+	{
+		long ret;
+		do
+		{
+#ifdef _WIN32
+			ret = _read(fd, p, static_cast<unsigned>(n > 0x40000000 ? 0x40000000 : n));
+#else
+			ret = static_cast<long>(read(fd, p, n));
+#endif
+		} while (ret < 0 && errno == EINTR);   // 被信号打断时重新读
+		return ret;
+	}
+
+	line_reader::line_reader(int file, size_type buffer_size)
+		: fd(file), own_fd(false), mapped(false), buf(nullptr), buf_size(0), cur(nullptr), last(nullptr),
+		eof(false), ok(true), lines(0)
+	{
+		if (fd < 0)
+		{
+			ok = false;
+			eof = true;
+			return;
+		}
+		init_buffer(buffer_size);
+	}
+
+	line_reader::line_reader(const char* path)
+		: fd(-1), own_fd(true), mapped(false), buf(nullptr), buf_size(0), cur(nullptr), last(nullptr),
+		eof(false), ok(true), lines(0)
+	{
+		fd = open_read_only(path);
+		if (fd < 0)
+		{
+			ok = false;
+			eof = true;
+			return;
+		}
+		if (!map_file())      // 映射失败时退回到分块读取
+			init_buffer(64 * 1024);
+	}
+
+	line_reader::~line_reader()
+	{
+		if (mapped)
+		{
+#ifndef _WIN32
+			if (buf != nullptr)
+				munmap(buf, buf_size);
+#endif
+		}
+		else if (buf != nullptr)
+		{
+			data_allocator::deallocate(buf, buf_size);
+		}
+		if (own_fd && fd >= 0)
+			close_file(fd);
+	}
+
+	void line_reader::init_buffer(size_type n)
+	{
+		buf_size = (n < 64) ? 64 : n;
+		buf = data_allocator::allocate(buf_size);
+		cur = last = buf;
+	}
+
+	bool line_reader::map_file()
+	{
+#ifdef _WIN32
+		return false;
+#else
+		struct stat st;
+		if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+			return false;
+		mapped = true;
+		eof = true;
+		if (st.st_size > 0)       // 空文件不能mmap，当作没有任何行
+		{
+			void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p == MAP_FAILED)
+			{
+				mapped = false;
+				eof = false;
+				return false;
+			}
+#ifdef MADV_SEQUENTIAL
+			madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);   // 提示内核按顺序预读
+#endif
+			buf = static_cast<char*>(p);
+			buf_size = static_cast<size_type>(st.st_size);
+		}
+		cur = buf;
+		last = buf + buf_size;
+		close_file(fd);           // 映射建立之后就不再需要fd了
+		fd = -1;
+		return true;
+#endif
+	}
+
+	bool line_reader::fill()
+	{
+		size_type remain = last - cur;
+		if (cur != buf)           // 把还没返回的半行移到缓冲区头部
+		{
+			memmove(buf, cur, remain);
+			cur = buf;
+			last = buf + remain;
+		}
+		if (remain == buf_size)   // 一行比整个缓冲区还长，缓冲区扩大一倍
+		{
+			size_type new_size = buf_size * 2;
+			char* tmp = data_allocator::allocate(new_size);
+			memcpy(tmp, buf, remain);
+			data_allocator::deallocate(buf, buf_size);
+			buf = tmp;
+			buf_size = new_size;
+			cur = buf;
+			last = buf + remain;
+		}
+		long n = read_file(fd, buf + remain, buf_size - remain);
+		if (n <= 0)
+		{
+			if (n < 0)
+				ok = false;
+			eof = true;
+			return false;
+		}
+		last += n;
+		return true;
+	}
+
+	bool line_reader::next_line(string_view& line)
+	{
+		size_type scanned = 0;    // [cur, cur + scanned)中已经确认没有'\n'，不需要重复扫描
+		for (;;)
+		{
+			const char* pos = simd_find_byte(cur + scanned, last, '\n');
+			if (pos != last)
+			{
+				line = string_view(cur, pos);
+				cur = pos + 1;
+				++lines;
+				return true;
+			}
+			if (eof)
+			{
+				if (cur == last)
+					return false;
+				line = string_view(cur, last);   // 最后一行没有'\n'
+				cur = last;
+				++lines;
+				return true;
+			}
+			scanned = last - cur;
+			fill();
+		}
+	}
+
+}  // namespace TinySTL
@@ -0,0 +1,280 @@
+#ifndef _PERSISTENT_MAP_IMPL_H_
+#define _PERSISTENT_MAP_IMPL_H_
+
+/*
+*    Author  @yyehl
+*/
+
+namespace TinySTL
+{
+	/*********************** 节点与引用计数 *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::create_node(const value_type& val, bool red) -> node*
+	{
+		node* x = static_cast<node*>(::operator new(sizeof(node)));
+		new (&x->refs) std::atomic<size_t>(1);
+		x->left = x->right = nullptr;
+		x->red = red;
+		construct(&x->value, val);
+		return x;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void persistent_rb_tree<Key, Value, KeyOfValue, Compare>::release(node* x)
+	{   // 引用计数减到0时回收节点，再释放它对两个孩子的引用；右子树递归，左边循环
+		while (x != nullptr && x->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			release(x->right);
+			node* l = x->left;
+			destroy(&x->value);
+			::operator delete(x);
+			x = l;
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::mut(node* x) -> node*
+	{   // x由一个只属于当前版本的父节点（或根）引用；引用计数为1时可以就地修改，否则复制一份，父节点改为引用复制品
+		if (x->refs.load(std::memory_order_acquire) == 1)
+			return x;
+		node* y = create_node(x->value, x->red);
+		y->left = retain(x->left);
+		y->right = retain(x->right);
+		release(x);
+		return y;
+	}
+
+	/*********************** 查找 *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::find_node(const key_type& k) const -> const node*
+	{
+		const node* x = root;
+		while (x != nullptr)
+		{
+			if (comp(k, key(x)))
+				x = x->left;
+			else if (comp(key(x), k))
+				x = x->right;
+			else
+				return x;
+		}
+		return nullptr;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::lower_bound(const key_type& k) const -> const_iterator
+	{   // 往左走时当前节点入栈，它们正是还没访问到的后继
+		const_iterator it;
+		for (const node* x = root; x != nullptr; )
+		{
+			if (!comp(key(x), k))
+			{
+				it.stack[it.depth++] = x;
+				x = x->left;
+			}
+			else
+				x = x->right;
+		}
+		return it;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::find(const key_type& k) const -> const_iterator
+	{
+		const_iterator it = lower_bound(k);
+		if (it == end() || comp(k, KeyOfValue()(*it)))
+			return end();
+		return it;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void persistent_rb_tree<Key, Value, KeyOfValue, Compare>::swap(self& x)
+	{
+		node* r = root; root = x.root; x.root = r;
+		size_type n = node_count; node_count = x.node_count; x.node_count = n;
+		Compare c = comp; comp = x.comp; x.comp = c;
+	}
+
+	/*********************** 左倾红黑树的调整 *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::rotate_left(node* h) -> node*
+	{
+		node* x = mut(h->right);
+		h->right = x->left;
+		x->left = h;
+		x->red = h->red;
+		h->red = true;
+		return x;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::rotate_right(node* h) -> node*
+	{
+		node* x = mut(h->left);
+		h->left = x->right;
+		x->right = h;
+		x->red = h->red;
+		h->red = true;
+		return x;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	void persistent_rb_tree<Key, Value, KeyOfValue, Compare>::flip_colors(node* h)
+	{   // 两个孩子的颜色也要改，先取得它们
+		h->red = !h->red;
+		h->left = mut(h->left);
+		h->left->red = !h->left->red;
+		h->right = mut(h->right);
+		h->right->red = !h->right->red;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::move_red_left(node* h) -> node*
+	{   // h为红，h->left和h->left->left都为黑：让h->left或它的一个孩子变红
+		flip_colors(h);
+		if (is_red(h->right->left))
+		{
+			h->right = rotate_right(h->right);
+			h = rotate_left(h);
+			flip_colors(h);
+		}
+		return h;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::move_red_right(node* h) -> node*
+	{
+		flip_colors(h);
+		if (is_red(h->left->left))
+		{
+			h = rotate_right(h);
+			flip_colors(h);
+		}
+		return h;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::balance(node* h) -> node*
+	{   // 恢复左倾：红链接只能在左边，不能连续两个红链接，两个孩子都红时分裂
+		if (is_red(h->right) && !is_red(h->left))
+			h = rotate_left(h);
+		if (is_red(h->left) && is_red(h->left->left))
+			h = rotate_right(h);
+		if (is_red(h->left) && is_red(h->right))
+			flip_colors(h);
+		return h;
+	}
+
+	/*********************** 插入 *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::_insert(node* h, const value_type& val, bool& inserted) -> node*
+	{
+		if (h == nullptr)
+		{
+			inserted = true;
+			return create_node(val, true);
+		}
+		const key_type& k = KeyOfValue()(val);
+		if (comp(k, key(h)))
+		{
+			h = mut(h);
+			h->left = _insert(h->left, val, inserted);
+		}
+		else if (comp(key(h), k))
+		{
+			h = mut(h);
+			h->right = _insert(h->right, val, inserted);
+		}
+		else
+		{   // 替换：value可能不能赋值（pair<const Key, T>），新建一个节点接过h的两个孩子
+			node* x = create_node(val, h->red);
+			x->left = retain(h->left);
+			x->right = retain(h->right);
+			release(h);
+			return x;
+		}
+		return balance(h);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	bool persistent_rb_tree<Key, Value, KeyOfValue, Compare>::insert_unique(const value_type& val)
+	{
+		if (find_node(KeyOfValue()(val)) != nullptr)   // 先查找，已存在时不复制路径
+			return false;
+		bool inserted = false;
+		root = _insert(root, val, inserted);
+		root->red = false;
+		++node_count;
+		return true;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	bool persistent_rb_tree<Key, Value, KeyOfValue, Compare>::insert_or_assign(const value_type& val)
+	{
+		bool inserted = false;
+		root = _insert(root, val, inserted);
+		root->red = false;
+		if (inserted)
+			++node_count;
+		return inserted;
+	}
+
+	/*********************** 删除 *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::_erase_min(node* h, node*& m) -> node*
+	{
+		h = mut(h);
+		if (h->left == nullptr)    // 左倾红黑树中没有左孩子的节点也没有右孩子
+		{
+			m = h;
+			return nullptr;
+		}
+		if (!is_red(h->left) && !is_red(h->left->left))
+			h = move_red_left(h);
+		h->left = _erase_min(h->left, m);
+		return balance(h);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::_erase(node* h, const key_type& k) -> node*
+	{   // 一路向下时保证当前节点或它的左孩子为红，删除的总是一个红节点或3-节点中的一个元素
+		h = mut(h);
+		if (comp(k, key(h)))
+		{
+			if (!is_red(h->left) && !is_red(h->left->left))
+				h = move_red_left(h);
+			h->left = _erase(h->left, k);
+		}
+		else
+		{
+			if (is_red(h->left))
+				h = rotate_right(h);
+			if (!comp(key(h), k) && h->right == nullptr)
+			{
+				release(h);
+				return nullptr;
+			}
+			if (!is_red(h->right) && !is_red(h->right->left))
+				h = move_red_right(h);
+			if (!comp(key(h), k))
+			{   // 用右子树中最小的节点m顶替h（移动节点而不是赋值value）
+				node* m;
+				node* r = _erase_min(h->right, m);
+				m->left = h->left;
+				m->right = r;
+				m->red = h->red;
+				h->left = h->right = nullptr;
+				release(h);
+				h = m;
+			}
+			else
+				h->right = _erase(h->right, k);
+		}
+		return balance(h);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	auto persistent_rb_tree<Key, Value, KeyOfValue, Compare>::erase(const key_type& k) -> size_type
+	{
+		if (find_node(k) == nullptr)
+			return 0;
+		root = mut(root);
+		if (!is_red(root->left) && !is_red(root->right))
+			root->red = true;
+		root = _erase(root, k);
+		if (root != nullptr)
+			root->red = false;
+		--node_count;
+		return 1;
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_PERSISTENT_MAP_IMPL_H_
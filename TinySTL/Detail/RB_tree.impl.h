@@ -1,5 +1,5 @@
 #ifndef _RB_TREE_IMPL_H_
-#define _RB_TREE_TMPL_H_
+#define _RB_TREE_IMPL_H_
 
 /*
 *  Author  @yyehl
@@ -8,8 +8,8 @@
 namespace TinySTL
 {
 	/*************** class rb_tree_iterator ******************************/
-	template<class Value, class Ref, class Ptr>
-	void rb_tree_iterator<Value, Ref, Ptr>::increase()
+	template<class Value, class Ref, class Ptr, bool OrderStat>
+	void rb_tree_iterator<Value, Ref, Ptr, OrderStat>::increase()
 	{
 		if (node->right != nullptr)  // 1ҽڵڣҷ֧Сڵ㣨ڵ㣩
 		{
@@ -17,87 +17,96 @@ namespace TinySTL
 			while (node->left != nullptr)
 				node = node->left;
 		}
-		else                        // ҽڵ㲻
+		else                        // ҽڵ㲻ڣҵһnodeС
 		{
 			tree_node* p = node->parent;
-			if (p->parent == node)
-				node = p;          // 2nodeΪڵ㣬header
-			else if (p->left == node)
-				node = p;          // 3nodeΪڵڵ㣬丸ڵ
-			else
+			while (node == p->right)
 			{
-				while (p->right == node)
-				{
-					node = p;
-					p = p->parent;  
-				}                    
-				node = p;           // 4:nodeΪڵҽڵ㣬nodeΪڵڵΪֹ
+				node = p;
+				p = p->parent;
 			}
+			if (node->right != p)   // 2nodeΪڵʱһֱߵheaderʱnode->right == pnodeͣheader
+				node = p;
 		}
 	}
-	template<class Value, class Ref, class Ptr>
-	void rb_tree_iterator<Value, Ref, Ptr>::decrease()
+	template<class Value, class Ref, class Ptr, bool OrderStat>
+	void rb_tree_iterator<Value, Ref, Ptr, OrderStat>::decrease()
 	{
 		if (node->color == RED && node->parent->parent == node)
-			node = node->right;  // 1:nodeΪheaderôrightmost
-		if (node->left != nullptr)
+			node = node->right;  // 1:nodeΪheaderend()ôrightmost
+		else if (node->left != nullptr)
 		{
 			node = node->left;
 			while (node->right != nullptr)
 				node = node->right;
-		}                        // 2ڵڣô֧ڵ㣨ڵ㣩
-		else     // ڵ
+		}                        // 2ڵڣô֧ڵ㣨ҽڵ㣩
+		else     // 3ڵ㣬ҵһnodeС
 		{
 			tree_node* p = node->parent;
-			if (p->right == node)
-				node = p;     // 3nodeΪڵҽڵ㣬丸ڵ
-			else
+			while (node == p->left)
 			{
-				while (p->left == node)
-				{
-					node = p;
-					p = p->parent;
-				}
-				node = p;    // 4nodeΪڵڵ㣬nodeΪڵҽڵΪֹ
+				node = p;
+				p = p->parent;
 			}
+			node = p;
 		}
 	}
 
 	/******************** class rb_tree **************************************/
-
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	auto rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::_insert(tree_node* x, tree_node* y, const value_type& x) -> iterator
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::rb_tree(const self& x)
+		: node_count(0), key_compare(x.key_compare)
 	{
-		tree_node* z;
-		if (y == header || x != nil || key_compare(KeyOfValue()(val), key(x)))
-		{ // ҪڵĸڵΪheaderҪĽڵ㲻ΪջvalkeyxkeyС
-			z = create_node(val);
-			left(z) = x;
+		init();
+		if (x.root() != nullptr)
+		{
+			root() = _copy(x.root(), header);
+			leftmost() = min_value_node(root());
+			rightmost() = max_value_node(root());
+			node_count = x.node_count;
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::operator = (const self& x) -> self&
+	{
+		if (this != &x)
+		{
+			self tmp(x);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_insert_node(tree_node* x, tree_node* y, tree_node* z) -> iterator
+	{   // zΪѾõ½ڵ㣬xΪnullptrʱʾһyߣλѾȷyΪ½ڵĸڵ
+		if (y == header || x != nullptr || key_compare(key(z), key(y)))
+		{ // y
+			left(y) = z;          // yΪheaderʱleftmost() = z
 			if (y == header)
 			{
 				root() = z;
 				rightmost() = z;
 			}
-			else if (y = leftmost())
+			else if (y == leftmost())
 				leftmost() = z;
 		}
 		else
 		{
-			z = create_node(val);
 			right(y) = z;
 			if (y == rightmost())
-				rightmost = z;
+				rightmost() = z;
 		}
 		parent(z) = y;
-		left(z) = right(z) = nil;
+		add_size_to_root(y, header, 1, order_tag());   // ½ڵȣСһ
 		// άֺ
 		rb_insert_balance(z, root());  // һΪڵ㣬ڶΪroot
 		++node_count;
 		return iterator(z);
 	}
 
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_insert_balance(tree_node* x, tree_node*& root)
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::rb_insert_balance(tree_node* x, tree_node*& root) -> bool
 	{
 		x->color = RED; // ½ڵδǰԶΪ
 		while (x != root && x->parent->color == RED) // xΪroot½ڵĸڵΪREDǲҪ
@@ -105,7 +114,7 @@ namespace TinySTL
 			if (x->parent == x->parent->parent->left) // xĸڵΪ丸ڵڵʱ
 			{
 				tree_node* y = x->parent->parent->right; //yΪxĲڵ
-				if (y != nil && y->color == RED)  //ڵΪ죬ֱӵɫ
+				if (y != nullptr && y->color == RED)  //ڵΪ죬ֱӵɫ
 				{
 					x->parent->parent->color = RED;
 					x->parent->color = BLACK;
@@ -127,7 +136,7 @@ namespace TinySTL
 			else  // ĻԳƣxĸڵΪ丸ڵҽڵ
 			{
 				tree_node* y = x->parent->parent->left;
-				if (y != nil && y->color == RED)  //ڵΪRED
+				if (y != nullptr && y->color == RED)  //ڵΪRED
 				{
 					y->color = BLACK;
 					x->parent->color = BLACK;
@@ -147,368 +156,909 @@ namespace TinySTL
 				}
 			}
 		}
+		bool grown = root->color == RED;
 		root->color = BLACK; //ڵԶΪ
+		return grown;
 	}
 
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	auto rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::_copy(tree_node* x, tree_node* y) -> tree_node*
-	{   // xΪcopyĽڵ㣬 ycopy½ڵĸڵ
-		if (x == nullptr) return nullptr;
-		tree_node* new_left;
-		tree_node* new_right;
-		tree_node* new_root;
-		new_left = _copy(x->left, x);
-		new_right = _copy(x->right, x);
-		new_root = clone_node(x);
-		new_root->left = new_left;
-		new_root->right = new_right;
-		new_root->parent = y;
-		return new_root;
-	}
-
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::_erase(tree_node* x)
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::rb_erase_balance(tree_node* z) -> tree_node*
 	{
-		if (x->left == nil && x->right == nil && x->color == RED) //1:xΪҶڵΪREDֱɾ
-		{
-			if (x->parent->left == x) // жx丸ڵڵ㻹ҽڵ㣬ΪҪı丸ڵĺָ
-				x->parent->left = nil;
-			else
-				x->parent->right = nil;
-			destroy_node(x);
-		} 
-		else if (x->right == nil && x->right == nil && x->color == BLACK) //2:xλҶڵ㣬ΪBLACKôתΪ˫
+		tree_node*& root = this->root();
+		tree_node* y = z;           // yΪԭλժµĽڵ㣺zֻһʱΪzΪzĺ
+		tree_node* x = nullptr;     // xΪyԭλõĽڵ㣨Ϊnullptr
+		tree_node* x_parent = nullptr;
+
+		if (y->left == nullptr)
+			x = y->right;
+		else if (y->right == nullptr)
+			x = y->left;
+		else
 		{
-			bool left_or_right = true;   // left is true
-			if (x == x->parent->left)
-			{
-				x->parent->left = nil;
-			}
-			else
-			{
-				x->parent->right = nil;
-				left_or_right = false;
-			}
-			rb_erase_balance(left_or_right, x->parent, root());  // 򣬵һΪɾڵĸڵ
-			destroy_node(x);
+			y = min_value_node(y->right);
+			x = y->right;
 		}
-		else if (x->left != nil && x->right == nil) //3:xֻڵҽڵ㣬xֻΪBLACK
-		{
-			if (x->left->color == RED) // xΪREDôֱӽӶxλãΪBLACK
-			{
-				if (x->parent->left == x)
-				{
-					x->parent->left = x->left;
-					x->left->parent = x->parent;
-				}
-				else
-				{
-					x->parent->right = x->left;
-					x->left->parent = x->parent;
-				}
-				x->left->color = BLACK;
-				destroy_node(x);
-			}
-			else  // ΪBLACKô ˫⡱Ҫɾĺڽڵxһɫĺӽڵ
-			{
-				bool left_or_right = true;   // left is true
-				if (x->parent->left == x)
-				{
-					x->parent->left = x->left;
-					x->left->parent = x->parent;
-				}
-				else
-				{
-					x->parent->right = x->left;
-					x->left->parent = x->parent;
-					left_or_right = false;
-				}
-				rb_erase_balance(left_or_right, x->parent, root());  // Ҫ
-				destroy_node(x);
-			}
-		}
-		else if (x->right != nil && x->left == nil) // 4:xֻҺӽڵûӽڵ
+		add_size_to_root(y->parent, header, -1, order_tag());   // yԭλõȣzСһ
+
+		if (y != z)    // zӣúyzλãǽڵֵָԪصĵӰ죩
 		{
-			if (x->right->color == RED) // ҺӽڵΪREDôֱӽҺӽڵ㶥xλãȻΪBLACK
+			z->left->parent = y;
+			y->left = z->left;
+			if (y != z->right)
 			{
-				if (x == x->parent->left)
-				{
-					x->right->parent = x->parent;
-					x->parent->left = x->right;
-				}
-				else
-				{
-					x->parent->right = x->right;
-					x->right->parent = x->parent;
-				}
-				x->right->color = BLACK;
-				destroy_node(x);
-			}
-			else  // xҺӽڵΪBLACKô˫⣬Ҫɾĺɫڵxһɫĺӽڵ
-			{
-				bool left_or_right = true;  // left is true
-				if (x == x->parent->left)
-				{
-					x->parent->left = x->right;
-					x->right->parent = x->parent;
-				}
-				else
-				{
-					x->parent->right = x->right;
-					x->right->parent = x->parent;
-					left_or_right = false;
-				}
-				rb_erase_balance(left_or_right, x->parent, root());
-				destroy_node(x);
+				x_parent = y->parent;
+				if (x != nullptr)
+					x->parent = y->parent;
+				y->parent->left = x;
+				y->right = z->right;
+				z->right->parent = y;
 			}
+			else
+				x_parent = y;
+			if (root == z)
+				root = y;
+			else if (z->parent->left == z)
+				z->parent->left = y;
+			else
+				z->parent->right = y;
+			y->parent = z->parent;
+			TinySTL::swap(y->color, z->color);
+			update_size(y, order_tag());
+			y = z;       // yָҪɾĽڵ
 		}
-		else  // 5xҺӣôöɾʽ֧Сڵ㶥xתΪ1234
+		else           // zֻһӣֱúxz
 		{
-			tree_node* y = nil;
-			y = x->right;
-			while (y->left != nil)           // ѰҶxڵyڵ
-			{
-				y = y->left;
-			} 
-			value_type tmp = x->value_field;   // ֻxyvalueɫ
-			x->value_field = y->value_field;
-			y->value_field = tmp;
-			_erase(y);                              // ˣѾ5תΪ1234
+			x_parent = y->parent;
+			if (x != nullptr)
+				x->parent = y->parent;
+			if (root == z)
+				root = x;
+			else if (z->parent->left == z)
+				z->parent->left = x;
+			else
+				z->parent->right = x;
+			if (leftmost() == z)
+				leftmost() = (z->right == nullptr) ? z->parent : min_value_node(x);
+			if (rightmost() == z)
+				rightmost() = (z->left == nullptr) ? z->parent : max_value_node(x);
 		}
 
-	}
-
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_erase_balance(bool l_or_r, tree_node* x, tree_node*& root)
-	{
-		bool complete = false;
-		while (x != root && x->color == BLACK)  // ִеڵxΪREDxΪREDôֱӰxΪBLACKˡ
+		if (y->color != RED)   // ɾǺɫڵ㣬xڵ·һڽڵ㣬˫⡱
 		{
-			if (l_or_r == true)  // left is true
+			while (x != root && (x == nullptr || x->color == BLACK))
 			{
-				tree_node* w = x->right;
-				if (w->color == RED)  // 1:,תΪ234
+				if (x == x_parent->left)
 				{
-					x->color = RED;
-					x->right->color = BLACK;
-					left_rotate(x, root);
-					w = x->right;
-				}
-				            /* Ϊ */
-				if (w->color == BLACK)   
-				{
-					if (w->left->color == BLACK && w->right->color == BLACK) // 2:ֵwΪBLACKҺӾΪBLACKwΪRED
+					tree_node* w = x_parent->right;    // xֵܽڵ
+					if (w->color == RED)   // 1:,תΪ234
 					{
-						w->color = RED;   
+						w->color = BLACK;
+						x_parent->color = RED;
+						left_rotate(x_parent, root);
+						w = x_parent->right;
 					}
-					else if (w->left->color == RED && w->right->color == BLACK)
+					if ((w->left == nullptr || w->left->color == BLACK) &&
+						(w->right == nullptr || w->right->color == BLACK))   // 2:ֵܵӾΪڣֵΪ죬
 					{
-						w->color = RED;                         //3:wΪBLACKֶΪREDֶΪBLACK
-						w->left->color = BLACK;                      // תΪ4
-						right_rotate(w);
+						w->color = RED;
+						x = x_parent;
+						x_parent = x_parent->parent;
 					}
-					else                                // 4:wΪBLACKֶΪBLACKֶΪRED
+					else
 					{
-						w->right->color = BLACK;
-						w->color = x->color;
-						x->color = BLACK;
-						left_rotate(x, root);
-						complete = true;
-						break;	
+						if (w->right == nullptr || w->right->color == BLACK)   // 3:ֶΪ졢ֶΪڣתΪ4
+						{
+							w->left->color = BLACK;
+							w->color = RED;
+							right_rotate(w, root);
+							w = x_parent->right;
+						}
+						w->color = x_parent->color;    // 4:ֶΪ죬֮
+						x_parent->color = BLACK;
+						if (w->right != nullptr)
+							w->right->color = BLACK;
+						left_rotate(x_parent, root);
+						break;
 					}
 				}
-				/* еxҪôΪREDҪôΪBLACKxѾƽ */
-				/* xΪ죬ô˳ѭڽִxɫΪBLACK */
-				/* ΪڣôᵼxΪxֱֵӺɫ߶Ȳ1ôxΪxparent*/
-				if (x->color == BLACK)
-					x = x->parent;
-			}
-			else    // right
-			{
-				tree_node* w = x->left;
-				if (w->color == RED)
+				else    // Գ
 				{
-					w->color = BLACK;
-					x->color = RED;
-					left_rotate(x, root);
-					w = x->left;
-				}
-				if (w->color == BLACK)
-				{
-					if (w->left->color == BLACK && w->right->color == BLACK)
+					tree_node* w = x_parent->left;
+					if (w->color == RED)
 					{
-						w->color = RED;
+						w->color = BLACK;
+						x_parent->color = RED;
+						right_rotate(x_parent, root);
+						w = x_parent->left;
 					}
-					else if (w->left->color == BLACK && w->right->color == RED)
+					if ((w->right == nullptr || w->right->color == BLACK) &&
+						(w->left == nullptr || w->left->color == BLACK))
 					{
 						w->color = RED;
-						w->right->color = BLACK;
-						left_rotate(w, root);
+						x = x_parent;
+						x_parent = x_parent->parent;
 					}
 					else
 					{
-						w->left->color = BLACK;
-						w->color = x->color;
-						x->color = BLACK;
-						right_rotate(x, root);
-						complete = true;
+						if (w->left == nullptr || w->left->color == BLACK)
+						{
+							w->right->color = BLACK;
+							w->color = RED;
+							left_rotate(w, root);
+							w = x_parent->left;
+						}
+						w->color = x_parent->color;
+						x_parent->color = BLACK;
+						if (w->left != nullptr)
+							w->left->color = BLACK;
+						right_rotate(x_parent, root);
 						break;
 					}
 				}
-				if (x->color == BLACK)
-					x = x->parent;
 			}
-			if (x == x->parent->left)
-				l_or_r = true;
-			else
-				l_or_r = false;
-		
-		}   // ѭ
+			if (x != nullptr)
+				x->color = BLACK;
+		}
+		return y;
+	}
 
-		if (!complete)   //ִеcompleteȻΪfalseҪôxΪRED ҪôxΪroot
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_copy(tree_node* x, tree_node* p) -> tree_node*
+	{   // xΪcopyĸ pΪڵĸڵ
+		tree_node* top = clone_node(x);
+		top->parent = p;
+		copy_size(top, x, order_tag());
+		if (x->right != nullptr)
+			top->right = _copy(x->right, top);
+		p = top;
+		x = x->left;
+		while (x != nullptr)      // һ·ѭݹ飬ݹȲ
 		{
-			if (l_or_r)
+			tree_node* y = clone_node(x);
+			copy_size(y, x, order_tag());
+			p->left = y;
+			y->parent = p;
+			if (x->right != nullptr)
+				y->right = _copy(x->right, y);
+			p = y;
+			x = x->left;
+		}
+		return top;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	template<class InputIterator>
+	InputIterator rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_build_sorted(InputIterator first, InputIterator last, bool unique)
+	{   // ֻڿʱã[first, last)ǰ׺ֱӽƽصһԪصλ
+		tree_node* head = nullptr;
+		tree_node* tail = nullptr;
+		size_type n = 0;
+		for (; first != last; ++first)
+		{
+			if (tail != nullptr)
 			{
-				x->right->color = RED;
-				x->color = BLACK;
+				const key_type& k = KeyOfValue()(*first);
+				if (key_compare(k, key(tail)))   // ǰ׺Ϊֹ
+					break;
+				if (unique && !key_compare(key(tail), k))  // ظļֵinsert_uniqueһȳֵ
+					continue;
 			}
+			tree_node* x = create_node(*first);  // η䣬right
+			if (tail == nullptr)
+				head = x;
 			else
-			{
-				x->left->color = RED;
-				x->color = BLACK;
-			}
+				tail->right = x;
+			tail = x;
+			++n;
+		}
+		if (n != 0)
+		{
+			size_type red_depth = 0;    // һȣfloor(log2(n))
+			for (size_type m = n; m > 1; m >>= 1)
+				++red_depth;
+			root() = _build(head, n, 0, red_depth);
+			root()->parent = header;
+			leftmost() = min_value_node(root());
+			rightmost() = max_value_node(root());
+			node_count = n;
+		}
+		return first;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_build(tree_node*& list, size_type n, size_type depth, size_type red_depth) -> tree_node*
+	{   // listаȡnڵ㽨СһҶֻ
+		// һźɫźɫÿ·ϵĺɫڵͬڵǺɫ
+		if (n == 0)
+			return nullptr;
+		size_type n_left = (n - 1) / 2;
+		tree_node* l = _build(list, n_left, depth + 1, red_depth);
+		tree_node* x = list;
+		list = list->right;
+		x->left = l;
+		if (l != nullptr)
+			l->parent = x;
+		x->right = _build(list, n - 1 - n_left, depth + 1, red_depth);
+		if (x->right != nullptr)
+			x->right->parent = x;
+		x->color = (depth == red_depth && depth != 0) ? RED : BLACK;
+		set_size(x, n, order_tag());
+		return x;
+	}
 
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	template<class InputIterator>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_equal(InputIterator first, InputIterator last)
+	{
+		if (node_count == 0)
+			first = _build_sorted(first, last, false);
+		for (; first != last; ++first)
+			insert_equal(end(), *first);   // ׷ұ
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	template<class InputIterator>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_unique(InputIterator first, InputIterator last)
+	{
+		if (node_count == 0)
+			first = _build_sorted(first, last, true);
+		for (; first != last; ++first)
+			insert_unique(end(), *first);   // ׷ұ
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	bool rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::operator == (const self& x) const
+	{
+		if (node_count != x.node_count)
+			return false;
+		for (const_iterator i = begin(), j = x.begin(); i != end(); ++i, ++j)
+		{
+			if (!(*i == *j))
+				return false;
 		}
+		return true;
 	}
 
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::rb_tree(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& x)
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::find(const key_type& k) -> iterator
 	{
-		init();
-		tree_node* new_root = _copy(x.root(), header);
-		header->parent = new_root;
-		node_count = x.node_count;
-		key_compare = x.key_compare;
-		for (tree_node* cur = root(); cur->left != nil; cur = cur->left)
-			header->left = cur;
-		for (tree_node* cur = root(); cur->right != nil; cur = cur->right)
-			header->right = cur;
-	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	auto rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::operator = (const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& x) -> rb_tree&
-	{
-		clear();
-		rb_tree(x);
-		return *this;
+		iterator j = lower_bound(k);
+		return (j == end() || key_compare(k, key(j.node))) ? end() : j;
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	bool rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::contain(const key_type& keyl) const
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::lower_bound(const key_type& k) -> iterator
 	{
-		return (find(key) == end()) ? false : true;
+		tree_node* y = header;     // һСkĽڵ
+		tree_node* x = root();
+		while (x != nullptr)
+		{
+			if (!key_compare(key(x), k)) // xڵkeyСk
+			{
+				y = x;
+				x = x->left;
+			}
+			else    // xڵkeyСk
+			{
+				x = x->right;
+			}
+		}
+		return iterator(y);
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	auto rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::find(const key_type& key) -> iterator
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::upper_bound(const key_type& k) -> iterator
 	{
-		tree_node* y = header;
+		tree_node* y = header;     // һkĽڵ
 		tree_node* x = root();
-		while (x != nil)
+		while (x != nullptr)
 		{
-			if (!key_compare(key(x), key)) //keyСxڵkey
+			if (key_compare(k, key(x)))
 			{
 				y = x;
 				x = x->left;
 			}
-			else    // keyڵxڵkey
+			else
 			{
 				x = x->right;
 			}
-		}   
-		iterator j = iterator(y);
-		return (j == end() || key_compare(key, key(j.node))) ? end() : j;
+		}
+		return iterator(y);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::count(const key_type& k) const -> size_type
+	{
+		size_type n = 0;
+		const_iterator it = lower_bound(k);   // һֵΪkĽڵ
+		for (; it != end() && !key_compare(k, KeyOfValue()(*it)); ++it)
+			++n;
+		return n;
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	auto rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(const value_type& val) -> iterator
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_get_insert_equal_pos(const key_type& k) -> pair<tree_node*, tree_node*>
 	{
 		tree_node* y = header;
 		tree_node* x = root();
-		while (x != nil)
+		while (x != nullptr)
 		{
 			y = x;
-			x = key_compare(KeyOfValue()(val), key(x)) ? left(x) : right(x);
+			x = key_compare(k, key(x)) ? left(x) : right(x);
 		}
-		return _insert(x, y, v); // xΪҪĽڵλãyΪҪĽڵĸڵ
+		return pair<tree_node*, tree_node*>(x, y); // xΪҪĽڵλãyΪҪĽڵĸڵ
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	auto rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(const value_type& val) -> pair<iterator, bool>
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_get_insert_unique_pos(const key_type& k) -> pair<tree_node*, tree_node*>
 	{
 		tree_node* x = root();
 		tree_node* y = header;
 		bool comp = true;
-		while (x  = nil)
+		while (x != nullptr)
 		{
 			y = x;
-			comp = key_compare(KeyOfValue()(val), key(x));
+			comp = key_compare(k, key(x));
 			x = comp ? left(x) : right(x);
 		}
-		iterator j = iterator(y);
-		if (comp) 
+		iterator j = iterator(y);   // jΪλõĸڵ㣬ǰΨһkȵĽڵ
+		if (comp)
 		{
-			if (j = begin())
-				return pair<iterator, bool>(_insert(x, y, val), true);
+			if (j == begin())
+				return pair<tree_node*, tree_node*>(x, y);
 			else
 				--j;
 		}
-		if (key_compare(key(j.node), KeyOfValue()(val)))
-			return pair<iterator, bool>(_insert(x, y, val), true);
-		return pair<iterator, bool>(j, false);
+		if (key_compare(key(j.node), k))
+			return pair<tree_node*, tree_node*>(x, y);
+		return pair<tree_node*, tree_node*>(j.node, nullptr);
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(tree_node* pos)
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_get_insert_hint_unique_pos(iterator hint, const key_type& k) -> pair<tree_node*, tree_node*>
+	{   // ½ڵhintǰhint֮䣨hint֮䣩ʱֱӹһĿն
+		tree_node* pos = hint.node;
+		if (pos == header)
+		{
+			if (node_count > 0 && key_compare(key(rightmost()), k))   // ׷ұ
+				return pair<tree_node*, tree_node*>(nullptr, rightmost());
+			return _get_insert_unique_pos(k);
+		}
+		if (key_compare(k, key(pos)))   // k < hinthintǰ
+		{
+			if (pos == leftmost())
+				return pair<tree_node*, tree_node*>(leftmost(), leftmost());
+			iterator before = hint;
+			--before;
+			if (key_compare(key(before.node), k))
+			{   // before < k < hintбһڸλпն
+				if (before.node->right == nullptr)
+					return pair<tree_node*, tree_node*>(nullptr, before.node);
+				return pair<tree_node*, tree_node*>(pos, pos);
+			}
+			return _get_insert_unique_pos(k);
+		}
+		if (key_compare(key(pos), k))   // hint < khintĺ
+		{
+			if (pos == rightmost())
+				return pair<tree_node*, tree_node*>(nullptr, rightmost());
+			iterator after = hint;
+			++after;
+			if (key_compare(k, key(after.node)))
+			{
+				if (pos->right == nullptr)
+					return pair<tree_node*, tree_node*>(nullptr, pos);
+				return pair<tree_node*, tree_node*>(after.node, after.node);
+			}
+			return _get_insert_unique_pos(k);
+		}
+		return pair<tree_node*, tree_node*>(pos, nullptr);   // hintļֵͬ
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_get_insert_hint_equal_pos(iterator hint, const key_type& k) -> pair<tree_node*, tree_node*>
 	{
-		_erase(pos);
+		tree_node* pos = hint.node;
+		if (pos == header)
+		{
+			if (node_count > 0 && !key_compare(k, key(rightmost())))
+				return pair<tree_node*, tree_node*>(nullptr, rightmost());
+			return _get_insert_equal_pos(k);
+		}
+		if (!key_compare(key(pos), k))  // k <= hint
+		{
+			if (pos == leftmost())
+				return pair<tree_node*, tree_node*>(leftmost(), leftmost());
+			iterator before = hint;
+			--before;
+			if (!key_compare(k, key(before.node)))  // before <= k <= hint
+			{
+				if (before.node->right == nullptr)
+					return pair<tree_node*, tree_node*>(nullptr, before.node);
+				return pair<tree_node*, tree_node*>(pos, pos);
+			}
+			return _get_insert_equal_pos(k);
+		}
+		// hint < k
+		if (pos == rightmost())
+			return pair<tree_node*, tree_node*>(nullptr, rightmost());
+		iterator after = hint;
+		++after;
+		if (!key_compare(key(after.node), k))   // hint < k <= after
+		{
+			if (pos->right == nullptr)
+				return pair<tree_node*, tree_node*>(nullptr, pos);
+			return pair<tree_node*, tree_node*>(after.node, after.node);
+		}
+		return _get_insert_equal_pos(k);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_insert_unique_node(pair<tree_node*, tree_node*> pos, tree_node* z) -> pair<iterator, bool>
+	{   // pos.secondΪnullptrʾֵѴڣz
+		if (pos.second == nullptr)
+		{
+			destroy_node(z);
+			return pair<iterator, bool>(iterator(pos.first), false);
+		}
+		return pair<iterator, bool>(_insert_node(pos.first, pos.second, z), true);
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::clear()
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_equal(const value_type& val) -> iterator
+	{
+		pair<tree_node*, tree_node*> pos = _get_insert_equal_pos(KeyOfValue()(val));
+		return _insert(pos.first, pos.second, val);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_unique(const value_type& val) -> pair<iterator, bool>
+	{
+		pair<tree_node*, tree_node*> pos = _get_insert_unique_pos(KeyOfValue()(val));
+		if (pos.second == nullptr)
+			return pair<iterator, bool>(iterator(pos.first), false);
+		return pair<iterator, bool>(_insert(pos.first, pos.second, val), true);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_equal(iterator hint, const value_type& val) -> iterator
 	{
-		destroy_tree(root());
+		pair<tree_node*, tree_node*> pos = _get_insert_hint_equal_pos(hint, KeyOfValue()(val));
+		return _insert(pos.first, pos.second, val);
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::swap(rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& x)
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_unique(iterator hint, const value_type& val) -> iterator
 	{
-		tree_node* tmp_header = x.header;
-		size_type tmp_count = x.node_count;
-		Compare tmp_comp = x.key_compare;
-		x.header = header;
-		x.node_count = node_count;
-		x.key_compare = key_compare;
-		header = tmp_header;
-		node_count = tmp_count;
-		key_compare = tmp_comp;
+		pair<tree_node*, tree_node*> pos = _get_insert_hint_unique_pos(hint, KeyOfValue()(val));
+		if (pos.second == nullptr)
+			return iterator(pos.first);
+		return _insert(pos.first, pos.second, val);
 	}
 
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::destroy_tree(tree_node* root)
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::erase(iterator pos)
+	{
+		destroy_node(rb_erase_balance(pos.node));
+		--node_count;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_unlink(tree_node* z) -> tree_node*
+	{
+		rb_erase_balance(z);
+		--node_count;
+		z->left = z->right = z->parent = nullptr;
+		set_size(z, 1, order_tag());
+		return z;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::extract(iterator pos) -> node_type
 	{
-		if (root == nil) return;
-		destroy_tree(root->left);
-		destroy_tree(root->right);
-		destroy_node(root);
+		return node_type(_unlink(pos.node));
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::extract(const key_type& k) -> node_type
+	{
+		iterator it = find(k);
+		if (it == end())
+			return node_type();
+		return extract(it);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_unique(node_type&& nh) -> pair<iterator, bool>
+	{
+		if (nh.empty())
+			return pair<iterator, bool>(end(), false);
+		pair<tree_node*, tree_node*> pos = _get_insert_unique_pos(key(nh.node));
+		if (pos.second == nullptr)
+			return pair<iterator, bool>(iterator(pos.first), false);
+		return pair<iterator, bool>(_insert_node(pos.first, pos.second, nh.release()), true);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::insert_equal(node_type&& nh) -> iterator
+	{
+		if (nh.empty())
+			return end();
+		pair<tree_node*, tree_node*> pos = _get_insert_equal_pos(key(nh.node));
+		return _insert_node(pos.first, pos.second, nh.release());
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::merge_unique(self& x)
+	{
+		if (this == &x)
+			return;
+		iterator it = x.begin();
+		while (it != x.end())
+		{
+			tree_node* z = it.node;
+			++it;
+			pair<tree_node*, tree_node*> pos = _get_insert_unique_pos(key(z));
+			if (pos.second != nullptr)
+				_insert_node(pos.first, pos.second, x._unlink(z));
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::merge_equal(self& x)
+	{
+		if (this == &x)
+			return;
+		iterator it = x.begin();
+		while (it != x.end())
+		{
+			tree_node* z = it.node;
+			++it;
+			pair<tree_node*, tree_node*> pos = _get_insert_equal_pos(key(z));
+			_insert_node(pos.first, pos.second, x._unlink(z));
+		}
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::erase(const key_type& k) -> size_type
+	{
+		size_type n = 0;
+		iterator it = find(k);
+		while (it != end() && !key_compare(k, KeyOfValue()(*it)))
+		{
+			erase(it++);
+			++n;
+		}
+		return n;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::clear()
+	{
+		if (root() != nullptr)
+		{
+			destroy_tree(root());
+			root() = nullptr;
+			leftmost() = rightmost() = header;
+			node_count = 0;
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::swap(self& x)
+	{
+		TinySTL::swap(header, x.header);
+		TinySTL::swap(node_count, x.node_count);
+		TinySTL::swap(key_compare, x.key_compare);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::destroy_tree(tree_node* x) -> size_type
+	{
+		size_type n = 0;
+		while (x != nullptr)    // ݹ飬ѭ
+		{
+			n += destroy_tree(x->right);
+			tree_node* y = x->left;
+			destroy_node(x);
+			x = y;
+			++n;
+		}
+		return n;
+	}
+
+	/************************** splitjoin뼯 ****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_detach(tree_node* x, size_type& h) -> tree_node*
+	{   // xΪһöparentÿգΪɫʱΪɫڸ߼һ
+		if (x != nullptr)
+		{
+			x->parent = nullptr;
+			if (x->color == RED)
+			{
+				x->color = BLACK;
+				++h;
+			}
+		}
+		return x;
 	}
 
-	
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::left_rotate(tree_node* x, tree_node*& root)
-	{   // ֻתɫɫrb_tree_balance
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_join(tree_node* l, size_type hl, tree_node* k, tree_node* r, size_type hr, size_type& h) -> tree_node*
+	{   // lеļֵСkrеļֵkؽϸһõң󣩼½ڸһͬĺڽڵx
+		// úڵk滻xxһΪkӣһϵΪO(|hl - hr| + 1)
+		k->parent = nullptr;
+		if (hl == hr)
+		{
+			k->left = l;
+			k->right = r;
+			if (l != nullptr) l->parent = k;
+			if (r != nullptr) r->parent = k;
+			k->color = BLACK;
+			update_size(k, order_tag());
+			h = hl + 1;
+			return k;
+		}
+		tree_node* root;
+		tree_node* p = nullptr;
+		size_type hx;
+		if (hl > hr)
+		{
+			root = l;
+			tree_node* x = l;
+			hx = hl;
+			while (!(hx == hr && (x == nullptr || x->color == BLACK)))
+			{
+				if (x->color == BLACK)
+					--hx;
+				p = x;
+				x = x->right;
+			}
+			k->left = x;
+			k->right = r;
+			p->right = k;
+			if (x != nullptr) x->parent = k;
+			if (r != nullptr) r->parent = k;
+			hx = hl;
+		}
+		else
+		{
+			root = r;
+			tree_node* x = r;
+			hx = hr;
+			while (!(hx == hl && (x == nullptr || x->color == BLACK)))
+			{
+				if (x->color == BLACK)
+					--hx;
+				p = x;
+				x = x->left;
+			}
+			k->left = l;
+			k->right = x;
+			p->left = k;
+			if (x != nullptr) x->parent = k;
+			if (l != nullptr) l->parent = k;
+			hx = hr;
+		}
+		k->parent = p;
+		update_size(k, order_tag());
+		update_size_to_root(p, nullptr, order_tag());
+		h = hx + (rb_insert_balance(k, root) ? 1 : 0);   // kΪɫ½ڵĵͬ
+		return root;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_join2(tree_node* l, size_type hl, tree_node* r, size_type hr, size_type& h) -> tree_node*
+	{   // ûмڵjoinlвĽڵΪмڵ
+		if (l == nullptr)
+		{
+			h = hr;
+			return r;
+		}
+		if (r == nullptr)
+		{
+			h = hl;
+			return l;
+		}
+		tree_node* ll;
+		tree_node* lr;
+		size_type hll, hlr;
+		tree_node* k = _split(l, hl, key(max_value_node(l)), ll, hll, lr, hlr);
+		return _join(ll, hll, k, r, hr, h);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_split(tree_node* t, size_type h, const key_type& k, tree_node*& l, size_type& hl, tree_node*& r, size_type& hr) -> tree_node*
+	{   // tlֵСkrֵkؼֵkĽڵ㣬û򷵻nullptrݹȲ
+		if (t == nullptr)
+		{
+			l = r = nullptr;
+			hl = hr = 0;
+			return nullptr;
+		}
+		size_type h_left = h - 1, h_right = h - 1;    // tΪɫӵĺڸһ
+		tree_node* lc = _detach(t->left, h_left);
+		tree_node* rc = _detach(t->right, h_right);
+		tree_node* m;
+		if (key_compare(k, key(t)))
+		{
+			tree_node* r1;
+			size_type hr1;
+			m = _split(lc, h_left, k, l, hl, r1, hr1);
+			r = _join(r1, hr1, t, rc, h_right, hr);
+		}
+		else if (key_compare(key(t), k))
+		{
+			tree_node* l1;
+			size_type hl1;
+			m = _split(rc, h_right, k, l1, hl1, r, hr);
+			l = _join(lc, h_left, t, l1, hl1, hl);
+		}
+		else
+		{
+			l = lc;
+			hl = h_left;
+			r = rc;
+			hr = h_right;
+			t->left = t->right = nullptr;
+			m = t;
+		}
+		return m;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_union(tree_node* a, size_type ha, tree_node* b, size_type hb, size_type& h, size_type& removed) -> tree_node*
+	{   // aĸb𿪣ҷֱϲaĸjoinֵͬʱaеĽڵ
+		if (b == nullptr)
+		{
+			h = ha;
+			return a;
+		}
+		if (a == nullptr)
+		{
+			h = hb;
+			return b;
+		}
+		tree_node* bl;
+		tree_node* br;
+		size_type hbl, hbr;
+		tree_node* m = _split(b, hb, key(a), bl, hbl, br, hbr);
+		if (m != nullptr)
+		{
+			destroy_node(m);
+			++removed;
+		}
+		size_type h_left = ha - 1, h_right = ha - 1;
+		tree_node* al = _detach(a->left, h_left);
+		tree_node* ar = _detach(a->right, h_right);
+		size_type hl, hr;
+		tree_node* l = _union(al, h_left, bl, hbl, hl, removed);
+		tree_node* r = _union(ar, h_right, br, hbr, hr, removed);
+		return _join(l, hl, a, r, hr, h);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_intersection(tree_node* a, size_type ha, tree_node* b, size_type hb, size_type& h, size_type& removed) -> tree_node*
+	{
+		if (a == nullptr || b == nullptr)
+		{
+			removed += destroy_tree(a) + destroy_tree(b);
+			h = 0;
+			return nullptr;
+		}
+		tree_node* bl;
+		tree_node* br;
+		size_type hbl, hbr;
+		tree_node* m = _split(b, hb, key(a), bl, hbl, br, hbr);
+		size_type h_left = ha - 1, h_right = ha - 1;
+		tree_node* al = _detach(a->left, h_left);
+		tree_node* ar = _detach(a->right, h_right);
+		size_type hl, hr;
+		tree_node* l = _intersection(al, h_left, bl, hbl, hl, removed);
+		tree_node* r = _intersection(ar, h_right, br, hbr, hr, removed);
+		if (m != nullptr)    // aĸbҲУaĸ
+		{
+			destroy_node(m);
+			++removed;
+			return _join(l, hl, a, r, hr, h);
+		}
+		destroy_node(a);
+		++removed;
+		return _join2(l, hl, r, hr, h);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::_difference(tree_node* a, size_type ha, tree_node* b, size_type hb, size_type& h, size_type& removed) -> tree_node*
+	{   // bĸa𿪣ҷֱbĸa֮ͬĽڵ㶼
+		if (a == nullptr || b == nullptr)
+		{
+			removed += destroy_tree(b);
+			h = ha;
+			return a;
+		}
+		tree_node* al;
+		tree_node* ar;
+		size_type hal, har;
+		tree_node* m = _split(a, ha, key(b), al, hal, ar, har);
+		if (m != nullptr)
+		{
+			destroy_node(m);
+			++removed;
+		}
+		size_type h_left = hb - 1, h_right = hb - 1;
+		tree_node* bl = _detach(b->left, h_left);
+		tree_node* br = _detach(b->right, h_right);
+		destroy_node(b);
+		++removed;
+		size_type hl, hr;
+		tree_node* l = _difference(al, hal, bl, h_left, hl, removed);
+		tree_node* r = _difference(ar, har, br, h_right, hr, removed);
+		return _join2(l, hl, r, hr, h);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::black_height() const -> size_type
+	{
+		size_type h = 0;
+		for (tree_node* x = root(); x != nullptr; x = x->left)
+			if (x->color == BLACK)
+				++h;
+		return h;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::take_root(tree_node* t, size_type n, self& x)
+	{   // tΪµĸڵΪnxĽڵ㶼Ѳt٣Ϊ
+		root() = t;
+		if (t != nullptr)
+		{
+			t->parent = header;
+			leftmost() = min_value_node(t);
+			rightmost() = max_value_node(t);
+		}
+		else
+			leftmost() = rightmost() = header;
+		node_count = n;
+		x.root() = nullptr;
+		x.leftmost() = x.rightmost() = x.header;
+		x.node_count = 0;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::set_union(self& x)
+	{
+		if (this == &x)
+			return;
+		size_type h, removed = 0, n = node_count + x.node_count;
+		tree_node* a = root();
+		tree_node* b = x.root();
+		if (a != nullptr) a->parent = nullptr;
+		if (b != nullptr) b->parent = nullptr;
+		tree_node* t = _union(a, black_height(), b, x.black_height(), h, removed);
+		take_root(t, n - removed, x);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::set_intersection(self& x)
+	{
+		if (this == &x)
+			return;
+		size_type h, removed = 0, n = node_count + x.node_count;
+		tree_node* a = root();
+		tree_node* b = x.root();
+		if (a != nullptr) a->parent = nullptr;
+		if (b != nullptr) b->parent = nullptr;
+		tree_node* t = _intersection(a, black_height(), b, x.black_height(), h, removed);
+		take_root(t, n - removed, x);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::set_difference(self& x)
+	{
+		if (this == &x)
+		{
+			clear();
+			return;
+		}
+		size_type h, removed = 0, n = node_count + x.node_count;
+		tree_node* a = root();
+		tree_node* b = x.root();
+		if (a != nullptr) a->parent = nullptr;
+		if (b != nullptr) b->parent = nullptr;
+		tree_node* t = _difference(a, black_height(), b, x.black_height(), h, removed);
+		take_root(t, n - removed, x);
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::left_rotate(tree_node* x, tree_node*& root)
+	{   // ֻתɫɫrb_insert_balancerb_erase_balance
 		tree_node* y = x->right;
 		x->right = y->left;
-		if (y->left != nil)
+		if (y->left != nullptr)
 		{
 			y->left->parent = x;
 		}
 		y->parent = x->parent;
 		if (x == root)
 		{
-			root == y; // 
+			root = y;
 		}
 		else if (x == x->parent->left)
 		{
@@ -518,15 +1068,17 @@ namespace TinySTL
 		{
 			x->parent->right = y;
 		}
-		y->left = x->parent;
+		y->left = x;
 		x->parent = y;
+		update_size(x, order_tag());     // ֻxy˱仯ȸx
+		update_size(y, order_tag());
 	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::right_rotate(tree_node* x, tree_node*& root)
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::right_rotate(tree_node* x, tree_node*& root)
 	{
 		tree_node* y = x->left;
 		x->left = y->right;
-		if (y->right != nil)
+		if (y->right != nullptr)
 		{
 			y->right->parent = x;
 		}
@@ -534,19 +1086,115 @@ namespace TinySTL
 
 		if (x == root)
 			root = y;
-		else if (x == x->parent->left)
+		else if (x == x->parent->right)
 		{
-			x->parent->left = y;
+			x->parent->right = y;
 		}
 		else
 		{
-			x->parent->right = y;
+			x->parent->left = y;
 		}
 		y->right = x;
 		x->parent = y;
+		update_size(x, order_tag());
+		update_size(y, order_tag());
+	}
+
+	/******************** ˳ͳ **************************************/
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::rank(const key_type& k, rb_tree_order_tag<true>) const -> size_type
+	{
+		size_type r = 0;
+		for (tree_node* x = root(); x != nullptr; )
+		{
+			if (key_compare(key(x), k))     // xСk
+			{
+				r += subtree_size(x->left) + 1;
+				x = x->right;
+			}
+			else
+				x = x->left;
+		}
+		return r;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::rank(const key_type& k, rb_tree_order_tag<false>) const -> size_type
+	{
+		size_type r = 0;
+		for (const_iterator it = begin(); it != end() && key_compare(KeyOfValue()(*it), k); ++it)
+			++r;
+		return r;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::nth(size_type n, rb_tree_order_tag<true>) -> iterator
+	{
+		if (n >= node_count)
+			return end();
+		tree_node* x = root();
+		while (true)
+		{
+			size_type l = subtree_size(x->left);
+			if (n < l)
+				x = x->left;
+			else if (n == l)
+				return iterator(x);
+			else
+			{
+				n -= l + 1;
+				x = x->right;
+			}
+		}
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::nth(size_type n, rb_tree_order_tag<false>) -> iterator
+	{
+		if (n >= node_count)
+			return end();
+		iterator it = begin();
+		while (n-- != 0)
+			++it;
+		return it;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::index_of(const_iterator pos, rb_tree_order_tag<true>) const -> size_type
+	{
+		tree_node* x = pos.node;
+		if (x == header)
+			return node_count;
+		size_type r = subtree_size(x->left);
+		for (; x != root(); x = x->parent)    // ÿδұȥڵ㼰posǰ
+		{
+			if (x == x->parent->right)
+				r += subtree_size(x->parent->left) + 1;
+		}
+		return r;
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::index_of(const_iterator pos, rb_tree_order_tag<false>) const -> size_type
+	{
+		size_type r = 0;
+		for (const_iterator it = begin(); it != pos; ++it)
+			++r;
+		return r;
+	}
+
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::count_range(const key_type& lo, const key_type& hi, rb_tree_order_tag<true>) const -> size_type
+	{
+		if (!key_compare(lo, hi))
+			return 0;
+		return rank(hi) - rank(lo);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	auto rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>::count_range(const key_type& lo, const key_type& hi, rb_tree_order_tag<false>) const -> size_type
+	{
+		size_type n = 0;
+		for (const_iterator it = lower_bound(lo); it != end() && key_compare(KeyOfValue()(*it), hi); ++it)
+			++n;
+		return n;
 	}
 
-}  // namespace Tiny STL
+}  // namespace TinySTL
 
 
 #endif // !_RB_TREE_IMPL_H_
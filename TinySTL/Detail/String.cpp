@@ -25,16 +25,7 @@ namespace TinySTL
 	}
 	string::string(const char* s, size_type n)
 	{
-		char* c = data_allocator::allocate(n * strlen(s));
-		_start = c;
-		for (size_type i = 0; i < n; ++i)
-		{
-			for (size_type j = 0; j < strlen(s); ++j)
-			{
-				*(c + i * strlen(s) + j) = *(s + j);
-			}
-		}
-		_finish = _end_of_storage = _start + n * strlen(s);
+		allocate_and_copy(s, s + n);
 	}
 	string::string(size_type n, char c)
 	{
@@ -0,0 +1,91 @@
+/*
+*	Author @yyehl
+*/
+
+#include "../String_pool.h"
+
+namespace TinySTL
+{
+	string_handle string_pool::intern(const char* s, size_type n)
+	{
+		unsigned int h = static_cast<unsigned int>(hash_fcn_string(s, n));
+		if ((entries.size() + 1) * 4 > slots.size() * 3)   // 装载率保持在3/4以下
+			grow_slots();
+		size_type mask = slots.size() - 1;
+		size_type i = h & mask;
+		while (slots[i] != 0)     // 线性探测，先比较hash和长度，都相同才比较内容
+		{
+			const entry& e = entries[slots[i] - 1];
+			if (e.hash == h && e.len == n && memcmp(e.data, s, n) == 0)
+				return string_handle(slots[i], h);
+			i = (i + 1) & mask;
+		}
+		entry e;
+		e.data = store(s, n);
+		e.len = n;
+		e.hash = h;
+		entries.push_back(e);
+		slots[i] = static_cast<string_handle::id_type>(entries.size());
+		bytes += n;
+		return string_handle(slots[i], h);
+	}
+
+	string_handle string_pool::find(const char* s, size_type n) const
+	{
+		if (slots.size() == 0)
+			return string_handle();
+		unsigned int h = static_cast<unsigned int>(hash_fcn_string(s, n));
+		size_type mask = slots.size() - 1;
+		for (size_type i = h & mask; slots[i] != 0; i = (i + 1) & mask)
+		{
+			const entry& e = entries[slots[i] - 1];
+			if (e.hash == h && e.len == n && memcmp(e.data, s, n) == 0)
+				return string_handle(slots[i], h);
+		}
+		return string_handle();
+	}
+
+	char* string_pool::store(const char* s, size_type n)
+	{
+		if (static_cast<size_type>(last - cur) < n + 1)   // 当前块放不下，就再申请一块
+		{
+			size_type len = (n + 1 > block_size) ? n + 1 : block_size;
+			cur = data_allocator::allocate(len);
+			last = cur + len;
+			blocks.push_back(pair<char*, size_type>(cur, len));
+		}
+		char* ret = cur;
+		memcpy(ret, s, n);
+		ret[n] = '\0';
+		cur += n + 1;
+		return ret;
+	}
+
+	void string_pool::grow_slots()
+	{
+		size_type new_n = (slots.size() == 0) ? 16 : slots.size() * 2;
+		vector<string_handle::id_type> tmp(new_n, 0u);
+		size_type mask = new_n - 1;
+		for (size_type id = 1; id <= entries.size(); ++id)   // entries里保存了hash，不需要重新计算
+		{
+			size_type i = entries[id - 1].hash & mask;
+			while (tmp[i] != 0)
+				i = (i + 1) & mask;
+			tmp[i] = static_cast<string_handle::id_type>(id);
+		}
+		slots.swap(tmp);
+	}
+
+	void string_pool::release()
+	{
+		for (size_type i = 0; i < blocks.size(); ++i)
+			data_allocator::deallocate(blocks[i].first, blocks[i].second);
+		blocks.clear();
+		entries.clear();
+		vector<string_handle::id_type> tmp;
+		slots.swap(tmp);
+		cur = last = nullptr;
+		bytes = 0;
+	}
+
+}  // namespace TinySTL
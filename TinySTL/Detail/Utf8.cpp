@@ -0,0 +1,366 @@
+/*
+*	Author @yyehl
+*/
+
+#include "../Utf8.h"
+#include "simd_functions.h"
+#include <cstring>
+
+namespace TinySTL
+{
+	/************************** 逐字节的实现 ************************************/
+	// 不支持SSSE3的CPU和非x86平台使用；ASCII部分每次跳过16个（SSE2）或8个字节，只有多字节序列逐字节检查
+
+	// 检查s开始的一个多字节序列（*s >= 0x80），合法时返回序列之后的位置，否则返回nullptr
+	static const unsigned char* utf8_check_sequence(const unsigned char* s, const unsigned char* last)
+	{
+		unsigned char c = *s;
+		size_t remain = last - s;
+		if (c >= 0xC2 && c <= 0xDF)          // 0xC0、0xC1开头的都是过长编码
+		{
+			if (remain < 2 || (s[1] & 0xC0) != 0x80)
+				return nullptr;
+			return s + 2;
+		}
+		if (c >= 0xE0 && c <= 0xEF)
+		{
+			if (remain < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80)
+				return nullptr;
+			if (c == 0xE0 && s[1] < 0xA0)     // 过长编码
+				return nullptr;
+			if (c == 0xED && s[1] > 0x9F)     // 代理区
+				return nullptr;
+			return s + 3;
+		}
+		if (c >= 0xF0 && c <= 0xF4)
+		{
+			if (remain < 4 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80)
+				return nullptr;
+			if (c == 0xF0 && s[1] < 0x90)     // 过长编码
+				return nullptr;
+			if (c == 0xF4 && s[1] > 0x8F)     // 大于U+10FFFF
+				return nullptr;
+			return s + 4;
+		}
+		return nullptr;
+	}
+
+	static bool utf8_validate_scalar(const char* str, size_t n)
+	{
+		const unsigned char* s = reinterpret_cast<const unsigned char*>(str);
+		const unsigned char* last = s + n;
+		while (s != last)
+		{
+#ifdef TINYSTL_SSE2
+			for (; last - s >= 16; s += 16)
+			{
+				unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s))));
+				if (mask != 0)
+				{
+					s += count_trailing_zeros(mask);
+					break;
+				}
+			}
+#else
+			for (; last - s >= 8; s += 8)
+			{
+				unsigned long long w;
+				memcpy(&w, s, sizeof(w));
+				if (w & 0x8080808080808080ull)
+					break;
+			}
+#endif
+			while (s != last && *s < 0x80)
+				++s;
+			if (s == last)
+				break;
+			s = utf8_check_sequence(s, last);
+			if (s == nullptr)
+				return false;
+		}
+		return true;
+	}
+
+#ifdef TINYSTL_X86_DISPATCH
+	/*
+	*  查表法：对每个字节，用前一个字节的高4位、低4位和当前字节的高4位查三张16项的表，
+	*  三个结果按位与，某一位不为0就说明这两个字节的组合属于对应的错误
+	*  三字节、四字节序列的第3、4个字节由 must_be_2_3_continuation 单独检查
+	*/
+	namespace utf8_detail
+	{
+		const unsigned char TOO_SHORT = 1 << 0;        // 11______ 0_______ 或 11______ 11______
+		const unsigned char TOO_LONG = 1 << 1;         // 0_______ 10______
+		const unsigned char OVERLONG_3 = 1 << 2;       // 11100000 100_____
+		const unsigned char TOO_LARGE = 1 << 3;        // 11110100 1001____ 等，大于U+10FFFF
+		const unsigned char SURROGATE = 1 << 4;        // 11101101 101_____
+		const unsigned char OVERLONG_2 = 1 << 5;       // 1100000_ 10______
+		const unsigned char TOO_LARGE_1000 = 1 << 6;   // 11110101 1000____ 等
+		const unsigned char OVERLONG_4 = 1 << 6;       // 11110000 1000____
+		const unsigned char TWO_CONTS = 1 << 7;        // 10______ 10______
+		const unsigned char CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+		// 前一个字节的高4位
+		alignas(32) const unsigned char byte_1_high[32] = {
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,   // 0_______ ASCII
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,                                        // 10______ 后续字节
+			TOO_SHORT | OVERLONG_2,                                                            // 1100____
+			TOO_SHORT,                                                                         // 1101____
+			TOO_SHORT | OVERLONG_3 | SURROGATE,                                                // 1110____
+			TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,                               // 1111____
+			// AVX2的pshufb在两个128位通道内分别查表，表要重复一遍
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+			TOO_SHORT | OVERLONG_2,
+			TOO_SHORT,
+			TOO_SHORT | OVERLONG_3 | SURROGATE,
+			TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+		};
+
+		// 前一个字节的低4位
+		alignas(32) const unsigned char byte_1_low[32] = {
+			CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,           // ____0000
+			CARRY | OVERLONG_2,                                     // ____0001
+			CARRY,                                                  // ____001_
+			CARRY,
+			CARRY | TOO_LARGE,                                      // ____0100
+			CARRY | TOO_LARGE | TOO_LARGE_1000,                     // ____0101
+			CARRY | TOO_LARGE | TOO_LARGE_1000,                     // ____011_
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,                     // ____1___
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,         // ____1101
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+
+			CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+			CARRY | OVERLONG_2,
+			CARRY,
+			CARRY,
+			CARRY | TOO_LARGE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000
+		};
+
+		// 当前字节的高4位
+		alignas(32) const unsigned char byte_2_high[32] = {
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,   // 0_______
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,           // 1000____
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,                            // 1001____
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,                             // 101_____
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,                                            // 11______
+
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+		};
+
+		// 块的最后3个字节分别不能是四字节、三字节及以上、任意多字节序列的首字节，否则序列延续到下一块
+		alignas(32) const unsigned char incomplete_max[32] = {
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+		};
+	}
+
+	/************************** AVX2 每次32个字节 ************************************/
+	struct utf8_avx2_checker
+	{
+		static const size_t width = 32;
+
+		__m256i error;
+		__m256i prev_input;
+		__m256i prev_incomplete;
+
+		TINYSTL_TARGET_AVX2 utf8_avx2_checker() : error(_mm256_setzero_si256()), prev_input(_mm256_setzero_si256()), prev_incomplete(_mm256_setzero_si256()) { }
+
+		TINYSTL_TARGET_AVX2 static __m256i table(const unsigned char* t) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(t)); }
+		TINYSTL_TARGET_AVX2 static __m256i high_nibble(__m256i v) { return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F)); }
+
+		// 把input整体右移N个字节，空出来的位置用prev的最后N个字节填充
+		template<int N>
+		TINYSTL_TARGET_AVX2 static __m256i prev(__m256i input, __m256i prev)
+		{
+			return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+		}
+
+		TINYSTL_TARGET_AVX2 void check_block(__m256i input)
+		{
+			using namespace utf8_detail;
+			if (_mm256_movemask_epi8(input) == 0)   // 纯ASCII，只要上一块没有未完成的序列就是合法的
+			{
+				error = _mm256_or_si256(error, prev_incomplete);
+				prev_incomplete = _mm256_setzero_si256();
+				prev_input = input;
+				return;
+			}
+			__m256i prev1 = prev<1>(input, prev_input);
+			__m256i sc = _mm256_and_si256(_mm256_and_si256(
+				_mm256_shuffle_epi8(table(byte_1_high), high_nibble(prev1)),
+				_mm256_shuffle_epi8(table(byte_1_low), _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)))),
+				_mm256_shuffle_epi8(table(byte_2_high), high_nibble(input)));
+			__m256i is_third = _mm256_subs_epu8(prev<2>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			__m256i is_fourth = _mm256_subs_epu8(prev<3>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			__m256i must23 = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+			error = _mm256_or_si256(error, _mm256_xor_si256(must23, sc));
+			prev_incomplete = _mm256_subs_epu8(input, table(incomplete_max));
+			prev_input = input;
+		}
+
+		TINYSTL_TARGET_AVX2 void check(const char* p) { check_block(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+		TINYSTL_TARGET_AVX2 bool has_error() const { return !_mm256_testz_si256(error, error); }
+
+		// 剩下的字节补0凑成一块，最后至少有一个0字节，未完成的序列会被当作TOO_SHORT检查出来
+		// 恰好整块结束时，补上的全0块负责检查上一块末尾未完成的序列
+		TINYSTL_TARGET_AVX2 static bool validate(const char* s, size_t n)
+		{
+			utf8_avx2_checker checker;
+			size_t i = 0;
+			for (; n - i >= 4 * width; i += 4 * width)   // 一次检查4块，错误在最后统一判断
+			{
+				checker.check(s + i);
+				checker.check(s + i + width);
+				checker.check(s + i + 2 * width);
+				checker.check(s + i + 3 * width);
+			}
+			for (; n - i >= width; i += width)
+				checker.check(s + i);
+			alignas(32) char tail[32] = { 0 };
+			if (n != i)      // 空的string_view中s可能为nullptr
+				memcpy(tail, s + i, n - i);
+			checker.check(tail);
+			return !checker.has_error();
+		}
+	};
+
+	/************************** SSSE3 每次16个字节 ************************************/
+	struct utf8_ssse3_checker
+	{
+		static const size_t width = 16;
+
+		__m128i error;
+		__m128i prev_input;
+		__m128i prev_incomplete;
+
+		TINYSTL_TARGET_SSSE3 utf8_ssse3_checker() : error(_mm_setzero_si128()), prev_input(_mm_setzero_si128()), prev_incomplete(_mm_setzero_si128()) { }
+
+		TINYSTL_TARGET_SSSE3 static __m128i table(const unsigned char* t) { return _mm_load_si128(reinterpret_cast<const __m128i*>(t)); }
+		TINYSTL_TARGET_SSSE3 static __m128i high_nibble(__m128i v) { return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)); }
+
+		template<int N>
+		TINYSTL_TARGET_SSSE3 static __m128i prev(__m128i input, __m128i prev) { return _mm_alignr_epi8(input, prev, 16 - N); }
+
+		TINYSTL_TARGET_SSSE3 void check_block(__m128i input)
+		{
+			using namespace utf8_detail;
+			if (_mm_movemask_epi8(input) == 0)
+			{
+				error = _mm_or_si128(error, prev_incomplete);
+				prev_incomplete = _mm_setzero_si128();
+				prev_input = input;
+				return;
+			}
+			__m128i prev1 = prev<1>(input, prev_input);
+			__m128i sc = _mm_and_si128(_mm_and_si128(
+				_mm_shuffle_epi8(table(byte_1_high), high_nibble(prev1)),
+				_mm_shuffle_epi8(table(byte_1_low), _mm_and_si128(prev1, _mm_set1_epi8(0x0F)))),
+				_mm_shuffle_epi8(table(byte_2_high), high_nibble(input)));
+			__m128i is_third = _mm_subs_epu8(prev<2>(input, prev_input), _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			__m128i is_fourth = _mm_subs_epu8(prev<3>(input, prev_input), _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			__m128i must23 = _mm_and_si128(_mm_or_si128(is_third, is_fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+			error = _mm_or_si128(error, _mm_xor_si128(must23, sc));
+			prev_incomplete = _mm_subs_epu8(input, table(utf8_detail::incomplete_max + 16));   // 只用表的后16项
+			prev_input = input;
+		}
+
+		TINYSTL_TARGET_SSSE3 void check(const char* p) { check_block(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+		TINYSTL_TARGET_SSSE3 bool has_error() const { return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF; }
+
+		// 剩下的字节补0凑成一块，最后至少有一个0字节，未完成的序列会被当作TOO_SHORT检查出来
+		// 恰好整块结束时，补上的全0块负责检查上一块末尾未完成的序列
+		TINYSTL_TARGET_SSSE3 static bool validate(const char* s, size_t n)
+		{
+			utf8_ssse3_checker checker;
+			size_t i = 0;
+			for (; n - i >= 4 * width; i += 4 * width)   // 一次检查4块，错误在最后统一判断
+			{
+				checker.check(s + i);
+				checker.check(s + i + width);
+				checker.check(s + i + 2 * width);
+				checker.check(s + i + 3 * width);
+			}
+			for (; n - i >= width; i += width)
+				checker.check(s + i);
+			alignas(32) char tail[32] = { 0 };
+			if (n != i)      // 空的string_view中s可能为nullptr
+				memcpy(tail, s + i, n - i);
+			checker.check(tail);
+			return !checker.has_error();
+		}
+	};
+#endif
+
+	typedef bool (*utf8_validate_fn)(const char*, size_t);
+
+	// 第一次调用时根据CPU选择实现
+	static utf8_validate_fn select_utf8_validate()
+	{
+#ifdef TINYSTL_X86_DISPATCH
+		if (cpu_has_avx2())
+			return utf8_avx2_checker::validate;
+		if (cpu_has_ssse3())
+			return utf8_ssse3_checker::validate;
+#endif
+		return utf8_validate_scalar;
+	}
+
+	bool utf8_validate(const char* s, size_t n)
+	{
+		static const utf8_validate_fn validate = select_utf8_validate();
+		return validate(s, n);
+	}
+
+	size_t utf8_length(const char* s, size_t n)
+	{
+		size_t count = 0;
+		size_t i = 0;
+#if defined(TINYSTL_AVX2)
+		const __m256i cont_max32 = _mm256_set1_epi8(static_cast<char>(0xBF));   // 有符号数下后续字节都 <= 0xBF (-65)
+		for (; n - i >= 32; i += 32)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+			count += popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, cont_max32))));
+		}
+#endif
+#if defined(TINYSTL_SSE2)
+		const __m128i cont_max = _mm_set1_epi8(static_cast<char>(0xBF));
+		for (; n - i >= 16; i += 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+			count += popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, cont_max))));
+		}
+#endif
+		for (; i != n; ++i)
+		{
+			if ((static_cast<unsigned char>(s[i]) & 0xC0) != 0x80)
+				++count;
+		}
+		return count;
+	}
+
+}  // namespace TinySTL
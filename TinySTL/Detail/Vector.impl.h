@@ -204,23 +204,23 @@ namespace TinySTL {
 		{
 			if (n <= size_type(_end_of_storage - _finish))
 			{
+				value_type val_copy = val;              // valܾǱvectorеԪ
 				size_type elem_after = _finish - pos;   // ֮ʣԪ
+				iterator old_finish = _finish;
 				if (n < elem_after)                 
-				{
-					auto iter = end();
-					auto new_finish = end() + n;
-					for ( ; iter != pos - 1; --iter, --new_finish)
-					{
-						*new_finish = *iter;
-					}
-					TinySTL::uninitialized_fill_n(pos, n, val);
+				{   // nԪع쵽δʼĿռϣֵд_end_of_storage֮
+					TinySTL::uninitialized_copy(old_finish - n, old_finish, old_finish);
 					_finish = _finish + n;
+					TinySTL::copy_backward(pos, old_finish - n, old_finish);
+					TinySTL::fill(pos, pos + n, val_copy);
 				}
 				else
 				{
-					TinySTL::uninitialized_copy(pos, end(), pos + n);
-					TinySTL::uninitialized_fill_n(pos, n , val);
-					_finish = _finish + n;
+					TinySTL::uninitialized_fill_n(old_finish, n - elem_after, val_copy);
+					_finish = _finish + (n - elem_after);
+					TinySTL::uninitialized_copy(pos, old_finish, _finish);
+					_finish = _finish + elem_after;
+					TinySTL::fill(pos, old_finish, val_copy);
 				} 
 			}
 			else 
@@ -262,22 +262,22 @@ namespace TinySTL {
 		if (len_insert <= len_left) 
 		{
 			size_type elem_after = end() - pos;
+			iterator old_finish = _finish;
 			if (len_insert < elem_after)
-			{
-				auto new_finish = _finish + len_insert;
-				auto iter = end();
-				for (size_type i = 0; i < elem_after; --iter, --new_finish)
-				{
-					*new_finish = *iter;
-				}
-				uninitialized_copy(first, last, pos);
+			{   // insert(pos, n, val)ͬȹĩβlen_insertԪأֵ
+				TinySTL::uninitialized_copy(old_finish - len_insert, old_finish, old_finish);
 				_finish = _finish + len_insert;
+				TinySTL::copy_backward(pos, old_finish - len_insert, old_finish);
+				TinySTL::copy(first, last, pos);
 			}
 			else
 			{
-				uninitialized_copy(pos, end(), pos + len_insert);
-				uninitialized_copy(first, last, pos);
-				_finish = _finish + len_insert;				
+				InputIterator mid = first + elem_after;
+				TinySTL::uninitialized_copy(mid, last, old_finish);
+				_finish = _finish + (len_insert - elem_after);
+				TinySTL::uninitialized_copy(pos, old_finish, _finish);
+				_finish = _finish + elem_after;
+				TinySTL::copy(first, mid, pos);
 			}
 		}
 		else
@@ -9,23 +9,158 @@
 *     hash functionsҪΪ˸hashtable.hhashfcnĬϲʱʹõģڲʹ
 *     hash functions ĹΪ˼hashtableԪصλ   
 *     ҪͣҪԶhash function
+*     stringstring_viewhash<>ֱString.hString_view.h
 */
 
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace TinySTL
 {
 	template<typename Key>
 	struct hash { };
 
-	// ַһתֻͣǷ䱾ʲôҲ
+	/*
+	*  hash_bytesһֽhashwyhash˼·ʵ
+	*  ÿζ8ֽڣÿ48ֽڷ·У64λ x 64λ = 128λĳ˷Ѹߵϣ
+	*  Ҳ㣬Ҫ'\0'βѩЧãʹkeyǿ⹹ģλλҲֲ
+	*/
+	namespace hash_detail
+	{
+		const unsigned long long secret[4] = {
+			0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+		};
 
-	inline size_t hash_fcn_string(const char* s)
+		// 128λ˻ĵ64λŻa64λŻb
+		inline void mum(unsigned long long* a, unsigned long long* b)
+		{
+#if defined(__SIZEOF_INT128__)
+			unsigned __int128 r = *a;
+			r *= *b;
+			*a = static_cast<unsigned long long>(r);
+			*b = static_cast<unsigned long long>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			*a = _umul128(*a, *b, b);
+#else
+			unsigned long long ha = *a >> 32, hb = *b >> 32, la = static_cast<unsigned>(*a), lb = static_cast<unsigned>(*b);
+			unsigned long long rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+			unsigned long long t = rl + (rm0 << 32), c = t < rl;
+			unsigned long long lo = t + (rm1 << 32);
+			c += lo < t;
+			*a = lo;
+			*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+		}
+		inline unsigned long long mix(unsigned long long a, unsigned long long b)
+		{
+			mum(&a, &b);
+			return a ^ b;
+		}
+
+		// ֽ룬memcpyҪ룬Żһloadָ
+		inline unsigned long long read8(const unsigned char* p) { unsigned long long v; memcpy(&v, p, 8); return v; }
+		inline unsigned long long read4(const unsigned char* p) { unsigned int v; memcpy(&v, p, 4); return v; }
+		inline unsigned long long read3(const unsigned char* p, size_t n)   // 1~3ֽ
+		{
+			return (static_cast<unsigned long long>(p[0]) << 16) | (static_cast<unsigned long long>(p[n >> 1]) << 8) | p[n - 1];
+		}
+	}
+
+	inline unsigned long long hash_bytes(const void* key, size_t len, unsigned long long seed = 0)
 	{
-		unsigned long h = 0;
-		for (; *s; ++s)
+		using namespace hash_detail;
+		const unsigned char* p = static_cast<const unsigned char*>(key);
+		seed ^= mix(seed ^ secret[0], secret[1]);
+		unsigned long long a, b;
+		if (len <= 16)
+		{
+			if (len >= 4)    // 4~16ֽڣβ4ֽڣص
+			{
+				a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+				b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+			}
+			else if (len > 0)
+			{
+				a = read3(p, len);
+				b = 0;
+			}
+			else
+			{
+				a = b = 0;
+			}
+		}
+		else
 		{
-			h = 5 * h + *s;
+			size_t i = len;
+			if (i > 48)
+			{
+				unsigned long long see1 = seed, see2 = seed;
+				do
+				{
+					seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+					see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+					see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+					p += 48;
+					i -= 48;
+				} while (i > 48);
+				seed ^= see1 ^ see2;
+			}
+			while (i > 16)
+			{
+				seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+				i -= 16;
+				p += 16;
+			}
+			a = read8(p + i - 16);    // 16ֽڣǰص
+			b = read8(p + i - 8);
 		}
-		return h;
+		a ^= secret[1];
+		b ^= seed;
+		mum(&a, &b);
+		return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+	}
+
+	// hashһ128λ˷ϣڵõhashֵλͬ
+	inline size_t hash_int(unsigned long long x)
+	{
+		return static_cast<size_t>(hash_detail::mix(x ^ hash_detail::secret[0], hash_detail::secret[1]));
+	}
+
+	inline size_t hash_fcn_string(const char* s)
+	{
+		return static_cast<size_t>(hash_bytes(s, strlen(s)));
+	}
+	// ȵİ汾Ҫ'\0'βstring_viewstring_poolʹ
+	inline size_t hash_fcn_string(const char* s, size_t n)
+	{
+		return static_cast<size_t>(hash_bytes(s, n));
+	}
+
+	// hashֵĸλֻϣڰ2ȡģflat_hashtable
+	// ûԶhashֱӷλķֲܲҪȻһȡλ
+	inline size_t hash_mix(size_t h)
+	{
+		unsigned long long x = h;
+		x ^= x >> 32;
+		x *= 0x9E3779B97F4A7C15ull;   // 2^64 / ƽָ
+		x ^= x >> 32;
+		return static_cast<size_t>(x);
+	}
+
+	// fastrangehӳ䵽[0, n) h * n / 2^64һγ˷ȡģhĸλ
+	// nΪ2ʱȡhlog2(n)λhҪȾhash_mix
+	inline size_t fastrange(size_t h, size_t n)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		return __umulh(h, n);
+#elif defined(__SIZEOF_INT128__)
+		return static_cast<size_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+#else
+		return static_cast<size_t>((static_cast<unsigned long long>(h & 0xFFFFFFFFu) * n) >> 32);   // 32λƽ̨
+#endif
 	}
 
 	// ģĸʽΪǰҪ  template<> Ϊ
@@ -33,57 +168,73 @@ namespace TinySTL
 	template<>
 	struct hash<char*>
 	{
-		size_t operator()(const char* s) { return hash_fcn_string(s); }
+		size_t operator()(const char* s) const { return hash_fcn_string(s); }
 	};
 	template<>
 	struct hash<const char*>
 	{
-		size_t operator()(const char* s) { return hash_fcn_string(s); }
+		size_t operator()(const char* s) const { return hash_fcn_string(s); }
 	};
 	template<>
 	struct hash<char>
 	{
-		size_t operator()(char c) { return c; }
+		size_t operator()(char c) const { return hash_int(c); }
 	};
 	template<>
 	struct hash<unsigned char>
 	{
-		size_t operator()(unsigned char c) { return c; }
+		size_t operator()(unsigned char c) const { return hash_int(c); }
 	};
 	template<>
 	struct hash<signed char>
 	{
-		size_t operator()(unsigned char c) { return c; }
+		size_t operator()(unsigned char c) const { return hash_int(c); }
 	};
 	template<>
 	struct hash<short>
 	{
-		size_t operator()(short x) { return x; }
+		size_t operator()(short x) const { return hash_int(x); }
 	};
 	template<>
 	struct hash<unsigned short>
 	{
-		size_t operator()(unsigned short x) { return x; }
+		size_t operator()(unsigned short x) const { return hash_int(x); }
 	};
 	template<>
 	struct hash<long>
 	{
-		size_t operator() (long x) { return x; }
+		size_t operator()(long x) const { return hash_int(x); }
 	};
 	template<>
 	struct hash<unsigned long>
 	{
-		size_t operator()(unsigned long x) { return x; }
+		size_t operator()(unsigned long x) const { return hash_int(x); }
 	};
 	template<>
 	struct hash<int>
 	{
-		size_t operator()(int x) { return x; }
+		size_t operator()(int x) const { return hash_int(x); }
 	};
 	template<>
 	struct hash<unsigned int>
 	{
-		size_t operator()(unsigned int x) { return x; }
+		size_t operator()(unsigned int x) const { return hash_int(x); }
+	};
+	template<>
+	struct hash<long long>
+	{
+		size_t operator()(long long x) const { return hash_int(x); }
+	};
+	template<>
+	struct hash<unsigned long long>
+	{
+		size_t operator()(unsigned long long x) const { return hash_int(x); }
+	};
+	// ָ밴ַhashchar*const char*⣬ǰַhash
+	template<class T>
+	struct hash<T*>
+	{
+		size_t operator()(T* p) const { return hash_int(reinterpret_cast<size_t>(p)); }
 	};
 
 
@@ -0,0 +1,255 @@
+#ifndef _SIMD_FUNCTIONS_H_
+#define _SIMD_FUNCTIONS_H_
+
+/*
+*  Author   @yyehl
+*/
+
+/*
+*     simd functions 是给字符串扫描类的组件使用的内部函数，属于内部使用
+*     编译器开启了SSE2/AVX2时使用对应的向量指令，每次处理16/32个字节，否则退回到逐字节的实现
+*     x64下SSE2总是可用的，SSSE3、AVX2需要编译时打开（-mssse3、/arch:AVX2 或 -mavx2）
+*     x86/x64上也可以不打开编译选项：函数加上TINYSTL_TARGET_SSSE3/TINYSTL_TARGET_AVX2（GCC/Clang的target属性，
+*     MSVC不需要），运行时用cpu_has_ssse3()/cpu_has_avx2()判断之后再调用
+*/
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TINYSTL_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#define TINYSTL_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define TINYSTL_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(TINYSTL_SSE2) && (defined(_MSC_VER) || defined(__GNUC__))
+#define TINYSTL_X86_DISPATCH
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define TINYSTL_TARGET_SSSE3
+#define TINYSTL_TARGET_AVX2
+#else
+#define TINYSTL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TINYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace TinySTL
+{
+#ifdef TINYSTL_X86_DISPATCH
+	// 运行时检查CPU是否支持SSSE3、AVX2（AVX2还要求操作系统保存YMM寄存器）
+	inline bool cpu_has_ssse3()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 9)) != 0;
+#else
+		return __builtin_cpu_supports("ssse3") != 0;
+#endif
+	}
+	inline bool cpu_has_avx2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		const int osxsave_avx = (1 << 27) | (1 << 28);
+		if ((info[2] & osxsave_avx) != osxsave_avx || (_xgetbv(0) & 6) != 6)
+			return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+#endif
+
+	// 返回x最低位的1的位置，x不能为0
+	inline unsigned count_trailing_zeros(unsigned x)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, x);
+		return index;
+#else
+		return __builtin_ctz(x);
+#endif
+	}
+
+	// 返回x最高位的1之前0的个数（按32位计），x不能为0
+	inline unsigned count_leading_zeros(unsigned x)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, x);
+		return 31 - index;
+#else
+		return __builtin_clz(x);
+#endif
+	}
+
+	// 返回x中1的个数
+	inline unsigned popcount(unsigned x)
+	{
+#if defined(__GNUC__)
+		return __builtin_popcount(x);
+#else
+		x = x - ((x >> 1) & 0x55555555u);
+		x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+		return (((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#endif
+	}
+
+	// 提示CPU提前把p所在的cache line读进cache，不影响程序的结果，用于批量查找时让多个cache miss重叠
+	inline void prefetch_read(const void* p)
+	{
+#if defined(TINYSTL_SSE2)
+		_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+		__builtin_prefetch(p);
+#else
+		(void)p;
+#endif
+	}
+
+	// 在[first, last)中查找字节c，找不到返回last，相当于不要求'\0'结尾的memchr
+	inline const char* simd_find_byte(const char* first, const char* last, char c)
+	{
+#ifdef TINYSTL_AVX2
+		const __m256i pattern32 = _mm256_set1_epi8(c);
+		for (; last - first >= 32; first += 32)
+		{
+			__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+			unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, pattern32)));
+			if (mask != 0)
+				return first + count_trailing_zeros(mask);
+		}
+#endif
+#ifdef TINYSTL_SSE2
+		const __m128i pattern = _mm_set1_epi8(c);
+		for (; last - first >= 16; first += 16)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern)));
+			if (mask != 0)
+				return first + count_trailing_zeros(mask);
+		}
+#endif
+		for (; first != last; ++first)   // 剩下不足一个向量的部分
+		{
+			if (*first == c)
+				return first;
+		}
+		return last;
+	}
+
+	/****************************** ASCII 大小写 ****************************************/
+	// 只处理'A'-'Z'和'a'-'z'，其他字节（包括>=0x80的UTF-8字节）保持不变
+
+	inline char ascii_lower_char(char c)
+	{
+		return static_cast<unsigned char>(c - 'A') < 26 ? static_cast<char>(c + 32) : c;
+	}
+	inline char ascii_upper_char(char c)
+	{
+		return static_cast<unsigned char>(c - 'a') < 26 ? static_cast<char>(c - 32) : c;
+	}
+
+#ifdef TINYSTL_SSE2
+	// 有符号比较：>=0x80的字节被当作负数，自然落在范围之外
+	inline __m128i simd_ascii_lower(__m128i v)
+	{
+		__m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+		return _mm_or_si128(v, _mm_and_si128(in_range, _mm_set1_epi8(0x20)));
+	}
+	inline __m128i simd_ascii_upper(__m128i v)
+	{
+		__m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1)));
+		return _mm_andnot_si128(_mm_and_si128(in_range, _mm_set1_epi8(0x20)), v);
+	}
+#endif
+#ifdef TINYSTL_AVX2
+	inline __m256i simd_ascii_lower(__m256i v)
+	{
+		__m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+		return _mm256_or_si256(v, _mm256_and_si256(in_range, _mm256_set1_epi8(0x20)));
+	}
+	inline __m256i simd_ascii_upper(__m256i v)
+	{
+		__m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), v));
+		return _mm256_andnot_si256(_mm256_and_si256(in_range, _mm256_set1_epi8(0x20)), v);
+	}
+#endif
+
+	// 把[first, last)转换成小写（upper为true时转换成大写）写到dst，dst可以等于first
+	inline void simd_ascii_case(char* dst, const char* first, const char* last, bool upper)
+	{
+#ifdef TINYSTL_AVX2
+		for (; last - first >= 32; first += 32, dst += 32)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+			v = upper ? simd_ascii_upper(v) : simd_ascii_lower(v);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v);
+		}
+#endif
+#ifdef TINYSTL_SSE2
+		for (; last - first >= 16; first += 16, dst += 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+			v = upper ? simd_ascii_upper(v) : simd_ascii_lower(v);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+		}
+#endif
+		for (; first != last; ++first, ++dst)
+			*dst = upper ? ascii_upper_char(*first) : ascii_lower_char(*first);
+	}
+
+	// 不区分大小写地比较a、b的前n个字节，返回第一个不同的位置，全部相同返回n
+	inline size_t simd_ascii_mismatch_nocase(const char* a, const char* b, size_t n)
+	{
+		size_t i = 0;
+#ifdef TINYSTL_AVX2
+		for (; n - i >= 32; i += 32)
+		{
+			__m256i va = simd_ascii_lower(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+			__m256i vb = simd_ascii_lower(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+			unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+			if (mask != 0)
+				return i + count_trailing_zeros(mask);
+		}
+#endif
+#ifdef TINYSTL_SSE2
+		for (; n - i >= 16; i += 16)
+		{
+			__m128i va = simd_ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+			__m128i vb = simd_ascii_lower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) ^ 0xFFFFu;
+			if (mask != 0)
+				return i + count_trailing_zeros(mask);
+		}
+#endif
+		for (; i != n; ++i)
+		{
+			if (ascii_lower_char(a[i]) != ascii_lower_char(b[i]))
+				return i;
+		}
+		return n;
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_SIMD_FUNCTIONS_H_
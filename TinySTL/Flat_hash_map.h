@@ -0,0 +1,102 @@
+#ifndef _FLAT_HASH_MAP_H_
+#define _FLAT_HASH_MAP_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include "Flat_hashtable.h"
+
+/*
+*  flat_hash_map以flat_hashtable（开放寻址）为底层，hash_map以hashtable（开链）为底层
+*  两者的使用方法和接口相同，flat_hash_map的元素pair<const Key, Value>直接存放在连续的数组里，
+*  查找时通常只需要读一次控制字节和一次元素
+*  区别：插入引起重建时，flat_hash_map原有的迭代器、指针、引用（包括operator[]返回的引用）都会失效
+*/
+
+namespace TinySTL
+{
+	template<class Key, class Value, class Hashfcn = hash<Key>, class Equalkey = equal_to<Key> >
+	class flat_hash_map
+	{
+	private:
+		typedef flat_hashtable<pair<const Key, Value>, Key, Hashfcn, select1st<pair<const Key, Value>>, Equalkey>    hashtable;
+
+		hashtable rep;
+	public:
+		typedef Value  data_type;
+		typedef Value  mapped_type;
+		typedef typename hashtable::value_type       value_type;
+		typedef typename hashtable::key_type         key_type;
+		typedef typename hashtable::hasher           hasher;
+		typedef typename hashtable::key_equal        key_equal;
+		typedef typename hashtable::size_type        size_type;
+		typedef typename hashtable::iterator         iterator;
+		typedef typename hashtable::const_iterator   const_iterator;
+		typedef typename hashtable::reference        reference;
+
+		hasher hash_funct() const { return rep.hash_funct(); }
+		key_equal key_eq() const { return rep.key_eq(); }
+
+	public:
+		flat_hash_map() : rep(0, hasher(), key_equal()) { }
+		explicit flat_hash_map(size_type n) : rep(n, hasher(), key_equal()) { }
+		flat_hash_map(size_type n, const hasher& hf, const key_equal& eqk) : rep(n, hf, eqk) { }
+		flat_hash_map(size_type n, const hasher& hf) : rep(n, hf, key_equal()) { }
+
+	public:
+		size_type size() const { return rep.size(); }
+		bool empty() const { return rep.empty(); }
+
+		iterator begin() { return rep.begin(); }
+		iterator end() { return rep.end(); }
+		const_iterator begin() const { return rep.begin(); }
+		const_iterator end() const { return rep.end(); }
+
+		void swap(flat_hash_map& hs) { rep.swap(hs.rep); }
+		bool operator == (const flat_hash_map& x) const { return rep == x.rep; }
+		bool operator != (const flat_hash_map& x) const { return !(*this == x); }
+	public:
+		pair<iterator, bool> insert(const value_type& val) { return rep.insert_unique(val); }
+		iterator find(const key_type& key) { return rep.find(key); }
+		const_iterator find(const key_type& key) const { return rep.find(key); }
+		size_type count(const key_type& key) const { return rep.count(key); }
+		void erase(iterator pos) { rep.erase(pos); }
+		size_type erase(const key_type& key) { return rep.erase(key); }
+		void clear() { rep.clear(); }
+
+		void resize(size_type n) { rep.resize(n); }
+		void reserve(size_type n) { rep.reserve(n); }
+		size_type buckets_count() const { return rep.buckets_count(); }
+		double load_factor() const { return rep.load_factor(); }
+
+		data_type& operator [] (const key_type& key)
+		{
+			iterator it = rep.find(key);
+			if (it == rep.end())   // 没找到
+				it = rep.insert_unique(value_type(key, data_type())).first;
+			return it->second;
+		}
+	};
+
+	template<class Key, class Value, class Hashfcn, class Equalkey>
+	bool operator == (const flat_hash_map<Key, Value, Hashfcn, Equalkey>& lhs, const flat_hash_map<Key, Value, Hashfcn, Equalkey>& rhs)
+	{
+		return lhs.operator==(rhs);
+	}
+	template<class Key, class Value, class Hashfcn, class Equalkey>
+	bool operator != (const flat_hash_map<Key, Value, Hashfcn, Equalkey>& lhs, const flat_hash_map<Key, Value, Hashfcn, Equalkey>& rhs)
+	{
+		return lhs.operator!=(rhs);
+	}
+	template<class Key, class Value, class Hashfcn, class Equalkey>
+	void swap(flat_hash_map<Key, Value, Hashfcn, Equalkey>& lhs, flat_hash_map<Key, Value, Hashfcn, Equalkey>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+
+}  // namespace TinySTL
+
+
+#endif // !_FLAT_HASH_MAP_H_
@@ -0,0 +1,93 @@
+#ifndef _FLAT_HASH_SET_H_
+#define _FLAT_HASH_SET_H_
+
+/*
+*  Author  @yyehl
+*/
+
+
+/*
+*  flat_hash_set以flat_hashtable（开放寻址）为底层，hash_set以hashtable（开链）为底层
+*  两者的使用方法和接口相同，flat_hash_set查找时访问的内存更少、更连续，每个元素只额外占用1个字节
+*  区别：插入引起重建时，flat_hash_set原有的迭代器、指针、引用都会失效
+*/
+
+
+#include "Flat_hashtable.h"
+
+namespace TinySTL
+{
+	template<class Value, class Hashfcn = hash<Value>, class Equalkey = equal_to<Value> >
+	class flat_hash_set
+	{
+	private:
+		typedef flat_hashtable<Value, Value, Hashfcn, identity<Value>, Equalkey>    hashtable;
+
+		hashtable rep;
+	public:
+		typedef typename hashtable::value_type       value_type;
+		typedef typename hashtable::key_type         key_type;
+		typedef typename hashtable::hasher           hasher;
+		typedef typename hashtable::key_equal        key_equal;
+		typedef typename hashtable::size_type        size_type;
+		typedef typename hashtable::const_iterator   iterator;     // 元素即为key，不允许通过迭代器修改
+		typedef typename hashtable::const_iterator   const_iterator;
+		typedef typename hashtable::const_reference  reference;
+
+		hasher hash_funct() const { return rep.hash_funct(); }
+		key_equal key_eq() const { return rep.key_eq(); }
+
+	public:
+		flat_hash_set() : rep(0, hasher(), key_equal()) { }
+		explicit flat_hash_set(size_type n) : rep(n, hasher(), key_equal()) { }
+		flat_hash_set(size_type n, const hasher& hf, const key_equal& eqk) : rep(n, hf, eqk) { }
+		flat_hash_set(size_type n, const hasher& hf) : rep(n, hf, key_equal()) { }
+
+	public:
+		size_type size() const { return rep.size(); }
+		bool empty() const { return rep.empty(); }
+
+		iterator begin() const { return rep.begin(); }
+		iterator end() const { return rep.end(); }
+
+		void swap(flat_hash_set& hs) { rep.swap(hs.rep); }
+		bool operator == (const flat_hash_set& x) const { return rep == x.rep; }
+		bool operator != (const flat_hash_set& x) const { return !(*this == x); }
+	public:
+		pair<iterator, bool> insert(const value_type& val)
+		{
+			pair<typename hashtable::iterator, bool> tmp = rep.insert_unique(val);
+			return pair<iterator, bool>(tmp.first, tmp.second);
+		}
+		iterator find(const key_type& key) const { return rep.find(key); }
+		size_type count(const key_type& key) const { return rep.count(key); }
+		void erase(iterator pos) { rep.erase(typename hashtable::iterator(pos.ctrl, const_cast<value_type*>(pos.slot))); }
+		size_type erase(const key_type& key) { return rep.erase(key); }
+		void clear() { rep.clear(); }
+
+		void resize(size_type n) { rep.resize(n); }
+		void reserve(size_type n) { rep.reserve(n); }
+		size_type buckets_count() const { return rep.buckets_count(); }
+		double load_factor() const { return rep.load_factor(); }
+	};
+
+	template<class Value, class Hashfcn, class Equalkey>
+	bool operator == (const flat_hash_set<Value, Hashfcn, Equalkey>& lhs, const flat_hash_set<Value, Hashfcn, Equalkey>& rhs)
+	{
+		return lhs.operator==(rhs);
+	}
+	template<class Value, class Hashfcn, class Equalkey>
+	bool operator != (const flat_hash_set<Value, Hashfcn, Equalkey>& lhs, const flat_hash_set<Value, Hashfcn, Equalkey>& rhs)
+	{
+		return lhs.operator!=(rhs);
+	}
+	template<class Value, class Hashfcn, class Equalkey>
+	void swap(flat_hash_set<Value, Hashfcn, Equalkey>& lhs, flat_hash_set<Value, Hashfcn, Equalkey>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_FLAT_HASH_SET_H_
@@ -0,0 +1,260 @@
+#ifndef _FLAT_HASHTABLE_H_
+#define _FLAT_HASHTABLE_H_
+
+/*
+*   Author   @yyehl
+*/
+
+#include "Functional.h"
+#include "Allocator.h"
+#include "Construct.h"
+#include "Utility.h"
+#include "Iterator.h"
+#include "./Detail/hash_functions.h"
+#include "./Detail/simd_functions.h"
+
+/*
+*  flat_hashtable 是开放寻址的hashtable（Swiss table），与开链的hashtable并列，作为flat_hash_map、flat_hash_set的底层
+*
+*  hashtable每个元素都是一个单独分配的节点，查找时先读bucket再读节点，至少两次不相关的cache miss
+*  flat_hashtable把元素直接放在一个连续的数组（slots）里，另外为每个slot配一个字节的控制字节（ctrl）：
+*      empty(0x80)    ：空位
+*      deleted(0xFE)  ：删除后留下的墓碑，查找时要越过它继续探测
+*      sentinel(0xFF) ：位于ctrl[capacity]，迭代器遍历到这里结束
+*      0~127          ：有元素，值为该元素hash值的低7位（h2）
+*  hash值的其余部分（h1）决定探测的起始位置，探测时一次取出16个控制字节（一个group），
+*  用SSE2一次比较出16个位置中h2相同的位置，只有这些位置才需要真正比较key，遇到empty就可以停止
+*
+*  capacity总是2^k - 1（至少15），ctrl共有capacity + 16个字节，末尾的15个字节是ctrl[0]~ctrl[14]的拷贝，
+*  这样从任意位置开始读一个group都不用考虑回绕
+*  装载率最大为7/8，元素与墓碑占满之后重建（墓碑多时按原大小重建，否则capacity翻倍）
+*
+*  注意：插入可能引起重建，重建之后所有的迭代器、指针、引用都会失效（与hashtable不同）
+*/
+
+namespace TinySTL
+{
+	typedef signed char   ctrl_t;
+	const ctrl_t ctrl_empty = -128;     // 0x80
+	const ctrl_t ctrl_deleted = -2;     // 0xFE
+	const ctrl_t ctrl_sentinel = -1;    // 0xFF
+
+	/*********************** struct flat_group *****************************/
+	// 一次处理16个控制字节，返回的mask中第i位为1表示第i个控制字节满足条件
+	struct flat_group
+	{
+		static const size_t width = 16;
+
+#ifdef TINYSTL_SSE2
+		__m128i ctrl;
+
+		explicit flat_group(const ctrl_t* p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) { }
+
+		unsigned match(ctrl_t h2) const
+		{
+			return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+		}
+		unsigned match_empty() const
+		{
+			return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), ctrl)));
+		}
+		unsigned match_empty_or_deleted() const   // 有符号比较，小于sentinel的只有empty和deleted
+		{
+			return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl)));
+		}
+#else
+		const ctrl_t* ctrl;
+
+		explicit flat_group(const ctrl_t* p) : ctrl(p) { }
+
+		unsigned match(ctrl_t h2) const
+		{
+			unsigned mask = 0;
+			for (size_t i = 0; i != width; ++i)
+				mask |= static_cast<unsigned>(ctrl[i] == h2) << i;
+			return mask;
+		}
+		unsigned match_empty() const { return match(ctrl_empty); }
+		unsigned match_empty_or_deleted() const
+		{
+			unsigned mask = 0;
+			for (size_t i = 0; i != width; ++i)
+				mask |= static_cast<unsigned>(ctrl[i] < ctrl_sentinel) << i;
+			return mask;
+		}
+#endif
+		// 从头开始连续的empty、deleted的个数
+		unsigned count_leading_empty_or_deleted() const
+		{
+			unsigned mask = match_empty_or_deleted() ^ 0xFFFFu;
+			return mask == 0 ? static_cast<unsigned>(width) : count_trailing_zeros(mask);
+		}
+	};
+
+	/*********************** strcut flat_hashtable_iterator *****************************/
+	template<class Value, class Ref, class Ptr>
+	struct flat_hashtable_iterator
+	{
+		typedef flat_hashtable_iterator<Value, Value&, Value*>              iterator;
+		typedef flat_hashtable_iterator<Value, const Value&, const Value*>  const_iterator;
+		typedef flat_hashtable_iterator<Value, Ref, Ptr>                    self;
+
+		typedef forward_iterator_tag  iterator_category;
+		typedef Value                 value_type;
+		typedef ptrdiff_t             difference_type;
+		typedef size_t                size_type;
+		typedef Ref                   reference;
+		typedef Ptr                   pointer;
+
+		/* 数据结构 */
+		const ctrl_t* ctrl;   // 当前位置的控制字节
+		Ptr slot;             // 当前位置的元素
+
+		flat_hashtable_iterator() : ctrl(nullptr), slot(nullptr) { }
+		flat_hashtable_iterator(const ctrl_t* c, Ptr s) : ctrl(c), slot(s) { }
+		template<class R, class P>       // iterator可以转换为const_iterator，反过来时slot的类型不匹配，编译不通过
+		flat_hashtable_iterator(const flat_hashtable_iterator<Value, R, P>& x) : ctrl(x.ctrl), slot(x.slot) { }
+
+		reference operator * () const { return *slot; }
+		pointer operator -> () const { return &(operator*()); }
+
+		self& operator ++ ()
+		{
+			++ctrl;
+			++slot;
+			skip_empty_or_deleted();
+			return *this;
+		}
+		self operator ++ (int)
+		{
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator == (const self& x) const { return ctrl == x.ctrl; }
+		bool operator != (const self& x) const { return ctrl != x.ctrl; }
+
+		// 跳过空位和墓碑，停在下一个元素或者sentinel上
+		void skip_empty_or_deleted()
+		{
+			while (*ctrl < ctrl_sentinel)
+			{
+				unsigned shift = flat_group(ctrl).count_leading_empty_or_deleted();
+				ctrl += shift;
+				slot += shift;
+			}
+		}
+	};
+
+	/************************* class flat_hashtable **************************************/
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc = allocator<Value>>
+	class flat_hashtable
+	{
+		/*
+		*  模板参数与hashtable相同
+		*  Value：元素的实值类型    Key：元素的键值类型
+		*  Hashfcn：hash functions，计算出的hash值会先经过hash_mix混合
+		*  Extractkey：从元素中取出key的方法    Equalkey：判断key相等的方法
+		*  Alloc：slots数组的空间分配器
+		*/
+
+	public:
+		typedef Hashfcn     hasher;
+		typedef Equalkey    key_equal;
+		typedef Value       value_type;
+		typedef Key         key_type;
+		typedef size_t      size_type;
+		typedef ptrdiff_t   difference_type;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+		typedef flat_hashtable_iterator<Value, Value&, Value*>              iterator;
+		typedef flat_hashtable_iterator<Value, const Value&, const Value*>  const_iterator;
+
+	private:
+		typedef Alloc                  slot_allocator;
+		typedef allocator<ctrl_t>      ctrl_allocator;
+		typedef flat_hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>  self;
+
+		static const size_type group_width = flat_group::width;
+		static const size_type min_capacity = 15;
+
+		// 以下是flat_hashtable的数据结构
+		ctrl_t* ctrl;            // capacity + group_width个控制字节
+		value_type* slots;       // capacity个元素的位置
+		size_type capacity;      // 0或者2^k - 1
+		size_type num_elems;
+		size_type growth_left;   // 还能放入多少个元素（empty的位置被占用时才减少）
+		hasher hash;
+		key_equal equals;
+		Extractkey get_key;
+
+	public:
+		explicit flat_hashtable(size_type n = 0, const Hashfcn& hf = Hashfcn(), const Equalkey& eql = Equalkey())
+			: ctrl(nullptr), slots(nullptr), capacity(0), num_elems(0), growth_left(0), hash(hf), equals(eql), get_key(Extractkey())
+		{
+			if (n != 0)
+				reserve(n);
+		}
+		flat_hashtable(const self& x);
+		~flat_hashtable();
+
+		self& operator = (const self& x);
+
+		pair<iterator, bool> insert_unique(const value_type& val);
+		void erase(iterator pos);
+		size_type erase(const key_type& key);
+		void clear();
+		void swap(self& x);
+		iterator find(const key_type& key);
+		const_iterator find(const key_type& key) const;
+		size_type count(const key_type& key) const { return find(key) == end() ? 0 : 1; }
+
+		iterator begin()
+		{
+			iterator it(ctrl, slots);
+			if (ctrl != nullptr)
+				it.skip_empty_or_deleted();
+			return it;
+		}
+		iterator end() { return iterator(ctrl + capacity, slots + capacity); }
+		const_iterator begin() const { return const_cast<self*>(this)->begin(); }
+		const_iterator end() const { return const_cast<self*>(this)->end(); }
+
+		bool operator == (const self& x) const;
+		bool operator != (const self& x) const { return !(*this == x); }
+
+		size_type size() const { return num_elems; }
+		bool empty() const { return num_elems == 0; }
+		size_type buckets_count() const { return capacity; }
+		double load_factor() const { return capacity == 0 ? 0.0 : static_cast<double>(num_elems) / capacity; }
+
+		hasher hash_funct() const { return hash; }
+		key_equal key_eq() const { return equals; }
+
+		void reserve(size_type n);                     // 保证放入n个元素之前不会再重建
+		void resize(size_type n) { reserve(n); }       // 与hashtable的接口保持一致
+
+	private:
+		static size_type growth_of(size_type cap) { return cap - cap / 8; }   // capacity对应的最大元素个数，装载率7/8
+		static size_type capacity_for(size_type n);      // 放下n个元素需要的最小capacity
+		static size_type h1(size_type h) { return h >> 7; }
+		static ctrl_t h2(size_type h) { return static_cast<ctrl_t>(h & 0x7F); }
+
+		size_type hash_of(const key_type& key) const { return hash_mix(hash(key)); }
+		size_type find_index(const key_type& key, size_type h) const;   // 找不到返回capacity
+		size_type find_first_non_full(size_type h) const;                // 第一个empty或deleted的位置
+		size_type prepare_insert(size_type h);           // 为hash值为h的新元素找位置，必要时重建
+		void set_ctrl(size_type i, ctrl_t c);            // 同时维护末尾的拷贝
+		void erase_at(size_type i);
+		void rehash_and_grow();
+		void rehash(size_type new_capacity);
+		void init_ctrl(size_type cap);
+		void deallocate_all();
+	};
+
+}   // namespace TinySTL
+
+#include "./Detail/Flat_hashtable.impl.h"
+
+#endif // !_FLAT_HASHTABLE_H_
@@ -0,0 +1,103 @@
+#ifndef _FLAT_MAP_H_
+#define _FLAT_MAP_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include "Flat_tree.h"
+
+/*
+*  flat_map以flat_tree（排好序的vector）为底层，map以rb_tree为底层
+*  两者的使用方法和接口相同，元素按key排序，查找都是O(logN)
+*  flat_map的元素pair<Key, T>连续存放，查找、遍历快，占用的内存少；单个元素的插入、删除为O(N)，适合读多写少的场合
+*  大量插入时使用insert(first, last)，只排序、合并一次
+*  区别：
+*      插入、删除之后，原有的迭代器、指针、引用（包括operator[]返回的引用）都会失效
+*      元素的类型是pair<Key, T>而不是pair<const Key, T>（vector中的元素需要能赋值），不要通过迭代器修改key
+*/
+
+namespace TinySTL
+{
+	template<class Key, class T, class Compare = less<Key>>
+	class flat_map
+	{
+	public:
+		typedef Key              key_type;
+		typedef T                data_type;
+		typedef T                mapped_type;
+		typedef pair<Key, T>     value_type;
+		typedef Compare          key_compare;
+
+	private:
+		typedef flat_tree<key_type, value_type, select1st<value_type>, key_compare>  rep_type;
+		rep_type t;    // 底层数据结构  flat_tree
+
+	public:
+		typedef typename rep_type::iterator            iterator;
+		typedef typename rep_type::const_iterator      const_iterator;
+		typedef typename rep_type::pointer             pointer;
+		typedef typename rep_type::const_pointer       const_pointer;
+		typedef typename rep_type::reference           reference;
+		typedef typename rep_type::const_reference     const_reference;
+		typedef typename rep_type::size_type           size_type;
+		typedef typename rep_type::difference_type     difference_type;
+
+	public:
+		flat_map() : t(key_compare()) { }
+		explicit flat_map(const Compare& cmp) : t(cmp) { }
+		template<class InputIterator>
+		flat_map(InputIterator first, InputIterator last) : t(key_compare()) { t.insert_unique(first, last); }
+
+		key_compare key_comp() const { return t.key_comp(); }
+		iterator begin() { return t.begin(); }
+		iterator end() { return t.end(); }
+		const_iterator begin() const { return t.begin(); }
+		const_iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		size_type capacity() const { return t.capacity(); }
+		void reserve(size_type n) { t.reserve(n); }
+		void shrink_to_fit() { t.shrink_to_fit(); }
+		void swap(flat_map& x) { t.swap(x.t); }
+
+		T& operator [] (const key_type& k) { return (*(t.insert_unique(value_type(k, T())).first)).second; }
+
+		pair<iterator, bool> insert(const value_type& x) { return t.insert_unique(x); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_unique(first, last); }
+		iterator erase(iterator pos) { return t.erase(pos); }
+		iterator erase(iterator first, iterator last) { return t.erase(first, last); }
+		size_type erase(const key_type& k) { return t.erase(k); }
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& k) { return t.find(k); }
+		const_iterator find(const key_type& k) const { return t.find(k); }
+		size_type count(const key_type& k) const { return t.count(k); }
+		iterator lower_bound(const key_type& k) { return t.lower_bound(k); }
+		const_iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+		iterator upper_bound(const key_type& k) { return t.upper_bound(k); }
+		const_iterator upper_bound(const key_type& k) const { return t.upper_bound(k); }
+		pair<iterator, iterator> equal_range(const key_type& k) { return t.equal_range(k); }
+		pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return t.equal_range(k); }
+
+		bool operator == (const flat_map& y) const { return t == y.t; }
+		bool operator != (const flat_map& y) const { return !(t == y.t); }
+	};
+
+	template<class Key, class T, class Compare>
+	bool operator == (const flat_map<Key, T, Compare>& x, const flat_map<Key, T, Compare>& y)
+	{
+		return x.operator==(y);
+	}
+	template<class Key, class T, class Compare>
+	bool operator != (const flat_map<Key, T, Compare>& x, const flat_map<Key, T, Compare>& y)
+	{
+		return x.operator!=(y);
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_FLAT_MAP_H_
@@ -0,0 +1,99 @@
+#ifndef _FLAT_SET_H_
+#define _FLAT_SET_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include "Flat_tree.h"
+
+/*
+*  flat_set以flat_tree（排好序的vector）为底层，set以rb_tree为底层
+*  两者的使用方法和接口相同，元素有序、不重复，查找都是O(logN)
+*  flat_set的元素连续存放，查找、遍历快，占用的内存少；单个元素的插入、删除为O(N)，适合读多写少的场合
+*  大量插入时使用insert(first, last)，只排序、合并一次
+*  区别：插入、删除之后，原有的迭代器、指针、引用都会失效
+*/
+
+namespace TinySTL
+{
+	template<class Key, class Compare = less<Key>>
+	class flat_set
+	{
+	public:
+		typedef Key      key_type;           // 在set中，key即是value
+		typedef Key      value_type;
+		typedef Compare  key_compare;
+		typedef Compare  value_compare;
+
+	private:
+		typedef flat_tree<Key, Key, identity<Key>, Compare>   rep_type;
+
+		rep_type t;
+	public:
+		typedef typename rep_type::const_iterator     iterator;        // 不允许通过迭代器修改元素
+		typedef typename rep_type::const_iterator     const_iterator;
+		typedef typename rep_type::const_pointer      pointer;
+		typedef typename rep_type::const_pointer      const_pointer;
+		typedef typename rep_type::const_reference    reference;
+		typedef typename rep_type::const_reference    const_reference;
+		typedef typename rep_type::size_type          size_type;
+		typedef typename rep_type::difference_type    difference_type;
+	private:
+		typedef typename rep_type::iterator           rep_iterator;
+
+	public:
+		flat_set() : t(Compare()) { }
+		explicit flat_set(const Compare& cmp) : t(cmp) { }
+		template<class InputIterator>
+		flat_set(InputIterator first, InputIterator last) : t(Compare()) { t.insert_unique(first, last); }
+
+		key_compare key_comp() const { return t.key_comp(); }
+		value_compare value_comp() const { return t.key_comp(); }
+		iterator begin() const { return t.begin(); }
+		iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		size_type capacity() const { return t.capacity(); }
+		void reserve(size_type n) { t.reserve(n); }
+		void shrink_to_fit() { t.shrink_to_fit(); }
+		void swap(flat_set& x) { t.swap(x.t); }
+
+		pair<iterator, bool> insert(const value_type& val)
+		{
+			pair<rep_iterator, bool> p = t.insert_unique(val);
+			return pair<iterator, bool>(p.first, p.second);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_unique(first, last); }
+		iterator erase(iterator pos) { return t.erase(t.begin() + (pos - begin())); }
+		iterator erase(iterator first, iterator last) { return t.erase(t.begin() + (first - begin()), t.begin() + (last - begin())); }
+		size_type erase(const key_type& key) { return t.erase(key); }
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& key) const { return t.find(key); }
+		size_type count(const key_type& key) const { return t.count(key); }
+		iterator lower_bound(const key_type& key) const { return t.lower_bound(key); }
+		iterator upper_bound(const key_type& key) const { return t.upper_bound(key); }
+		pair<iterator, iterator> equal_range(const key_type& key) const { return t.equal_range(key); }
+
+		bool operator == (const flat_set& y) const { return t == y.t; }
+		bool operator != (const flat_set& y) const { return !(t == y.t); }
+	};
+
+	template<class Key, class Compare>
+	bool operator == (const flat_set<Key, Compare>& x, const flat_set<Key, Compare>& y)
+	{
+		return x.operator==(y);
+	}
+	template<class Key, class Compare>
+	bool operator != (const flat_set<Key, Compare>& x, const flat_set<Key, Compare>& y)
+	{
+		return x.operator!=(y);
+	}
+
+}   // namespace TinySTL
+
+
+#endif // !_FLAT_SET_H_
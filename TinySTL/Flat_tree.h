@@ -0,0 +1,136 @@
+#ifndef _FLAT_TREE_H_
+#define _FLAT_TREE_H_
+
+/*
+*   Author   @yyehl
+*/
+
+#include "Functional.h"
+#include "Utility.h"
+#include "Vector.h"
+#include "Algorithm.h"
+
+/*
+*  flat_tree 是按key排好序的vector，作为flat_map、flat_set的底层，与rb_tree、btree并列
+*
+*  元素连续存放，没有任何指针，查找用lower_bound、upper_bound二分查找，遍历就是顺序扫描数组
+*  适合读多写少、建好之后很少修改的表（配置表、路由表）
+*  单个元素的插入、删除要移动后面的所有元素，为O(N)；
+*  批量插入insert_unique(first, last)先把新元素全部追加到末尾，只排序这一段，再与原有的元素合并一次，为O(N + MlogM)
+*
+*  注意：插入、删除之后原有的迭代器、指针、引用都会失效
+*/
+
+namespace TinySTL
+{
+	/************************* class flat_tree **************************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	class flat_tree
+	{
+		/*
+		*  模板参数与rb_tree相同
+		*  Key：键值类型    Value：元素类型    KeyOfValue：从元素中取出key的方法    Compare：key的比较方法
+		*/
+
+	public:
+		typedef Key                  key_type;
+		typedef Value                value_type;
+		typedef Compare              key_compare;
+		typedef value_type*          pointer;
+		typedef const value_type*    const_pointer;
+		typedef value_type&          reference;
+		typedef const value_type&    const_reference;
+		typedef size_t               size_type;
+		typedef ptrdiff_t            difference_type;
+		typedef vector<Value>        container_type;
+		typedef typename container_type::iterator        iterator;
+		typedef typename container_type::const_iterator  const_iterator;
+
+	private:
+		typedef flat_tree<Key, Value, KeyOfValue, Compare>  self;
+
+		// 给lower_bound、upper_bound、sort用的比较函数，分别比较（元素，key）、（key，元素）、（元素，元素）
+		// 分成三个仿函数，是因为在flat_set中Key与Value是同一个类型，写成重载会冲突
+		struct value_key_less
+		{
+			Compare comp;
+			explicit value_key_less(const Compare& c) : comp(c) { }
+			bool operator () (const Value& x, const Key& k) const { return comp(KeyOfValue()(x), k); }
+		};
+		struct key_value_less
+		{
+			Compare comp;
+			explicit key_value_less(const Compare& c) : comp(c) { }
+			bool operator () (const Key& k, const Value& x) const { return comp(k, KeyOfValue()(x)); }
+		};
+		struct value_less
+		{
+			Compare comp;
+			explicit value_less(const Compare& c) : comp(c) { }
+			bool operator () (const Value& x, const Value& y) const { return comp(KeyOfValue()(x), KeyOfValue()(y)); }
+		};
+
+		// 以下是flat_tree的数据结构
+		container_type c;     // 按key从小到大排好序，key不重复
+		key_compare comp;
+
+	public:
+		explicit flat_tree(const Compare& cmp = Compare()) : c(), comp(cmp) { }
+
+		key_compare key_comp() const { return comp; }
+		iterator begin() { return c.begin(); }
+		iterator end() { return c.end(); }
+		const_iterator begin() const { return c.begin(); }
+		const_iterator end() const { return c.end(); }
+		bool empty() const { return c.empty(); }
+		size_type size() const { return c.size(); }
+		size_type max_size() const { return size_type(-1) / sizeof(value_type); }
+		size_type capacity() const { return c.capacity(); }
+		void reserve(size_type n) { c.reserve(n); }
+		void shrink_to_fit() { c.shrink_to_fit(); }
+		void swap(self& x)
+		{
+			c.swap(x.c);
+			TinySTL::swap(comp, x.comp);
+		}
+
+		pair<iterator, bool> insert_unique(const value_type& val);
+		template<class InputIterator>
+		void insert_unique(InputIterator first, InputIterator last);   // 追加、排序、合并，只排序一次
+
+		iterator erase(iterator pos) { return c.erase(pos); }
+		iterator erase(iterator first, iterator last) { return c.erase(first, last); }
+		size_type erase(const key_type& key);
+		void clear() { c.clear(); }
+
+		iterator lower_bound(const key_type& key) { return TinySTL::lower_bound(c.begin(), c.end(), key, value_key_less(comp)); }
+		iterator upper_bound(const key_type& key) { return TinySTL::upper_bound(c.begin(), c.end(), key, key_value_less(comp)); }
+		const_iterator lower_bound(const key_type& key) const { return const_cast<self*>(this)->lower_bound(key); }
+		const_iterator upper_bound(const key_type& key) const { return const_cast<self*>(this)->upper_bound(key); }
+		iterator find(const key_type& key)
+		{
+			iterator it = lower_bound(key);
+			return (it == end() || comp(key, KeyOfValue()(*it))) ? end() : it;
+		}
+		const_iterator find(const key_type& key) const { return const_cast<self*>(this)->find(key); }
+		size_type count(const key_type& key) const { return find(key) == end() ? 0 : 1; }
+		pair<iterator, iterator> equal_range(const key_type& key)
+		{
+			iterator it = lower_bound(key);     // key不重复，equal_range最多只有一个元素
+			return pair<iterator, iterator>(it, (it == end() || comp(key, KeyOfValue()(*it))) ? it : it + 1);
+		}
+		pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			pair<iterator, iterator> p = const_cast<self*>(this)->equal_range(key);
+			return pair<const_iterator, const_iterator>(p.first, p.second);
+		}
+
+		bool operator == (const self& x) const { return c == x.c; }
+		bool operator != (const self& x) const { return !(*this == x); }
+	};
+
+}   // namespace TinySTL
+
+#include "./Detail/Flat_tree.impl.h"
+
+#endif // !_FLAT_TREE_H_
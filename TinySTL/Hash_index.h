@@ -0,0 +1,283 @@
+#ifndef _HASH_INDEX_H_
+#define _HASH_INDEX_H_
+
+/*
+*	Author  @yyehl
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "Allocator.h"
+#include "hash_map.h"
+
+/*
+*  hash_index：保存在文件中的只读hash表，用mmap映射进来之后直接查找，不需要反序列化
+*
+*  hash_map每次启动都要重新插入所有元素，元素很多时要花很长时间；
+*  write_hash_index把hash_map（或者任意的key/value序列）写成下面的格式，之后hash_index打开文件即可使用
+*
+*  文件格式（所有位置都是相对于文件开头的偏移量，不含指针，映射到任何地址都可以使用）：
+*      hash_index_header             文件头，记录各部分的偏移量、元素个数、key/value的大小
+*      ctrl[capacity]                每个slot一个字节：0为空，否则为0x80 | hash值的高7位
+*      slots[capacity]               每个slot为 { Key key; Value value; }，起始位置按64字节对齐
+*  开放寻址、线性探测，capacity为2的幂，装载率不超过0.7
+*
+*  限制：
+*      Key与Value必须是trivially copyable的类型（整数、POD结构体），key按字节比较，所以Key中不能有填充字节
+*      文件使用本机的字节序和结构体布局，文件头中记录了字节序标记和key/value/slot的大小，不一致时拒绝打开
+*      hash函数（hash_index_hash）是文件格式的一部分，不使用hash<Key>，以后也不能修改，否则旧文件无法查找
+*/
+
+namespace TinySTL
+{
+	/*********************** 文件格式 *****************************/
+	struct hash_index_header
+	{
+		char magic[8];                    // "TSHIDX1"
+		unsigned int endian;              // 写入0x01020304，读出来不同说明字节序不同
+		unsigned int key_size;
+		unsigned int value_size;
+		unsigned int slot_size;
+		unsigned long long capacity;      // slot的个数，2的幂
+		unsigned long long count;         // 元素个数
+		unsigned long long ctrl_offset;
+		unsigned long long slots_offset;
+		unsigned long long file_size;
+	};
+
+	template<class Key, class Value>
+	struct hash_index_slot
+	{
+		Key key;
+		Value value;
+	};
+
+	const unsigned int hash_index_endian = 0x01020304u;
+
+	// 固定的hash函数：每次取8个字节做乘法混合，最后用splitmix64的finalizer打散
+	inline unsigned long long hash_index_hash(const void* key, size_t n)
+	{
+		const unsigned char* p = static_cast<const unsigned char*>(key);
+		unsigned long long h = 0xcbf29ce484222325ull ^ n;
+		for (; n >= 8; n -= 8, p += 8)
+		{
+			unsigned long long w;
+			memcpy(&w, p, 8);
+			h = (h ^ w) * 0x100000001b3ull;
+			h ^= h >> 29;
+		}
+		if (n != 0)
+		{
+			unsigned long long w = 0;
+			memcpy(&w, p, n);
+			h = (h ^ w) * 0x100000001b3ull;
+		}
+		h ^= h >> 30;
+		h *= 0xbf58476d1ce4e5b9ull;
+		h ^= h >> 27;
+		h *= 0x94d049bb133111ebull;
+		h ^= h >> 31;
+		return h;
+	}
+
+	// 检查data处的size个字节是不是一个完整、合法的索引，并且key/value/slot的大小一致
+	bool hash_index_valid(const void* data, size_t size, size_t key_size, size_t value_size, size_t slot_size);
+	// 把size个字节写入path：先写到path.tmp，再改名覆盖原文件，正在映射原文件的读者不受影响
+	bool hash_index_write_file(const char* path, const void* data, size_t size);
+
+	/*********************** class mapped_file *****************************/
+	// 只读地映射整个文件，析构时解除映射
+	class mapped_file
+	{
+	private:
+		const void* addr;
+		size_t len;
+#ifdef _WIN32
+		void* file_handle;
+		void* map_handle;
+#endif
+
+	public:
+		mapped_file();
+		~mapped_file() { close(); }
+
+		bool open(const char* path);
+		void close();
+		bool is_open() const { return addr != nullptr; }
+		const void* data() const { return addr; }
+		size_t size() const { return len; }
+
+	private:
+		mapped_file(const mapped_file&);              // 持有映射，不允许复制
+		mapped_file& operator = (const mapped_file&);
+	};
+
+	/*********************** 写入 *****************************/
+	// 把[first, last)中的count个元素（first->first为key，first->second为value）写成索引文件
+	// key重复时保留后面的value；实际的元素个数多于count、放不下时返回false
+	template<class Key, class Value, class InputIterator>
+	bool write_hash_index(const char* path, InputIterator first, InputIterator last, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+			"hash_index requires trivially copyable Key and Value");
+		typedef hash_index_slot<Key, Value> slot;
+
+		unsigned long long capacity = 16;
+		while (capacity * 7 < count * 10ull)        // 装载率不超过0.7
+			capacity <<= 1;
+		const unsigned long long ctrl_offset = sizeof(hash_index_header);
+		const unsigned long long slots_offset = (ctrl_offset + capacity + 63) & ~63ull;
+		const unsigned long long file_size = slots_offset + capacity * sizeof(slot);
+
+		const size_t n = static_cast<size_t>(file_size);
+		char* buf = allocator<char>::allocate(n);
+		memset(buf, 0, n);                          // slot中的填充字节也清零，同样的输入总是得到同样的文件
+
+		unsigned char* ctrl = reinterpret_cast<unsigned char*>(buf + ctrl_offset);
+		char* slots = buf + slots_offset;
+		const unsigned long long mask = capacity - 1;
+		unsigned long long num = 0;
+		for (; first != last; ++first)
+		{
+			const Key& key = first->first;
+			const unsigned long long h = hash_index_hash(&key, sizeof(Key));
+			const unsigned char tag = static_cast<unsigned char>(0x80 | (h >> 57));
+			unsigned long long i = h & mask;
+			while (ctrl[i] != 0 && !(ctrl[i] == tag && memcmp(slots + i * sizeof(slot) + offsetof(slot, key), &key, sizeof(Key)) == 0))
+				i = (i + 1) & mask;
+			if (ctrl[i] == 0)
+			{
+				if ((num + 1) * 10 > capacity * 7)    // 实际的元素个数比count多，放不下了
+				{
+					allocator<char>::deallocate(buf, n);
+					return false;
+				}
+				ctrl[i] = tag;
+				memcpy(slots + i * sizeof(slot) + offsetof(slot, key), &key, sizeof(Key));
+				++num;
+			}
+			memcpy(slots + i * sizeof(slot) + offsetof(slot, value), &first->second, sizeof(Value));
+		}
+
+		hash_index_header header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, "TSHIDX1", 8);
+		header.endian = hash_index_endian;
+		header.key_size = sizeof(Key);
+		header.value_size = sizeof(Value);
+		header.slot_size = sizeof(slot);
+		header.capacity = capacity;
+		header.count = num;
+		header.ctrl_offset = ctrl_offset;
+		header.slots_offset = slots_offset;
+		header.file_size = file_size;
+		memcpy(buf, &header, sizeof(header));
+
+		const bool ok = hash_index_write_file(path, buf, n);
+		allocator<char>::deallocate(buf, n);
+		return ok;
+	}
+
+	template<class Key, class Value, class Hashfcn, class Equalkey, class RehashPolicy, bool CacheHash>
+	bool write_hash_index(const char* path, const hash_map<Key, Value, Hashfcn, Equalkey, RehashPolicy, CacheHash>& m)
+	{
+		return write_hash_index<Key, Value>(path, m.begin(), m.end(), m.size());
+	}
+
+	/*********************** class hash_index *****************************/
+	template<class Key, class Value>
+	class hash_index
+	{
+		static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+			"hash_index requires trivially copyable Key and Value");
+
+	public:
+		typedef Key      key_type;
+		typedef Value    data_type;
+		typedef size_t   size_type;
+
+	private:
+		typedef hash_index_slot<Key, Value>  slot;
+
+		// 以下是hash_index的数据结构，全部指向映射的内存
+		mapped_file file;
+		const unsigned char* ctrl;
+		const char* slots;
+		unsigned long long mask;    // capacity - 1
+		size_type num_elems;
+
+	public:
+		hash_index() : ctrl(nullptr), slots(nullptr), mask(0), num_elems(0) { }
+		explicit hash_index(const char* path) : ctrl(nullptr), slots(nullptr), mask(0), num_elems(0) { open(path); }
+
+		// 映射path并检查文件头，失败时返回false
+		bool open(const char* path)
+		{
+			close();
+			if (!file.open(path))
+				return false;
+			if (!attach(file.data(), file.size()))
+			{
+				file.close();
+				return false;
+			}
+			return true;
+		}
+		// 使用已经在内存中的索引（比如嵌在别的文件里、或者自己映射的），data的生存期由使用者保证
+		bool attach(const void* data, size_type size)
+		{
+			if (!hash_index_valid(data, size, sizeof(Key), sizeof(Value), sizeof(slot)))
+				return false;
+			const char* base = static_cast<const char*>(data);
+			hash_index_header header;
+			memcpy(&header, base, sizeof(header));
+			ctrl = reinterpret_cast<const unsigned char*>(base + header.ctrl_offset);
+			slots = base + header.slots_offset;
+			mask = header.capacity - 1;
+			num_elems = static_cast<size_type>(header.count);
+			return true;
+		}
+		void close()
+		{
+			file.close();
+			ctrl = nullptr;
+			slots = nullptr;
+			mask = 0;
+			num_elems = 0;
+		}
+
+		bool is_open() const { return ctrl != nullptr; }
+		size_type size() const { return num_elems; }
+		bool empty() const { return num_elems == 0; }
+
+		// 找到时返回指向映射内存中value的指针，在close()之前一直有效；找不到返回nullptr
+		const Value* find(const Key& key) const
+		{
+			if (ctrl == nullptr)
+				return nullptr;
+			const unsigned long long h = hash_index_hash(&key, sizeof(Key));
+			const unsigned char tag = static_cast<unsigned char>(0x80 | (h >> 57));
+			// 正常的文件至少有一个空slot，探测到空slot就停；但ctrl不在校验范围之内，损坏的文件可能没有空slot，
+			// 所以最多探测capacity次，保证一定会停下来
+			unsigned long long i = h & mask;
+			for (unsigned long long n = 0; n <= mask && ctrl[i] != 0; ++n, i = (i + 1) & mask)
+			{
+				const slot* s = reinterpret_cast<const slot*>(slots + i * sizeof(slot));
+				if (ctrl[i] == tag && memcmp(&s->key, &key, sizeof(Key)) == 0)
+					return &s->value;
+			}
+			return nullptr;
+		}
+		size_type count(const Key& key) const { return find(key) == nullptr ? 0 : 1; }
+
+	private:
+		hash_index(const hash_index&);
+		hash_index& operator = (const hash_index&);
+	};
+
+}  // namespace TinySTL
+
+
+#endif // !_HASH_INDEX_H_
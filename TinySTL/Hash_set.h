@@ -12,6 +12,8 @@
 *  setЧΪO(logN) hash_setЧƽΪO(1)
 *  hash_setʹ÷ͽӿڣsetȫͬ
 *  hash_set ʵֵΪֵֵʵֵ
+*  һģRehashPolicyĬΪprime_rehash_policyƵʱԻpow2_rehash_policyʡȥȡģĳ
+*  CacheHashΪtrueʱڵбhashֵrehashʱ¼hashʺstringȼhashkey
 */
 
 
@@ -19,30 +21,32 @@
 
 namespace TinySTL
 {
-	template<class Value, class Hashfcn = hash<Value>, class Equalkey = equal_to<Value> >
+	template<class Value, class Hashfcn = hash<Value>, class Equalkey = equal_to<Value>, class RehashPolicy = prime_rehash_policy, bool CacheHash = false>
 	class hash_set
 	{
 	private:
-		typedef hashtable<Value, Value, Hashfcn, identity<Value>, Equalkey>    hashtable;
+		typedef hashtable<Value, Value, Hashfcn, identity<Value>, Equalkey, RehashPolicy, CacheHash>    ht;
 
-		hashtable rep;
+		ht rep;
 	public:
-		typedef typename hashtable::value_type     value_type;
-		typedef typename hashtable::key_type       key_type;
-		typedef typename hashtable::hasher         hasher;
-		typedef typename hashtable::key_equal      key_equal;
-		typedef typename hashtable::size_type      size_type;
-		typedef typename hashtable::iterator       iterator;
-		typedef typename hashtable::reference      reference;
+		typedef typename ht::value_type     value_type;
+		typedef typename ht::key_type       key_type;
+		typedef typename ht::hasher         hasher;
+		typedef typename ht::key_equal      key_equal;
+		typedef typename ht::size_type      size_type;
+		typedef typename ht::iterator       iterator;
+		typedef typename ht::reference      reference;
 
 		hasher hash_funct() const { return Hashfcn(); }
-		hasher key_eq() const { return Equalkey(); }
+		key_equal key_eq() const { return Equalkey(); }
 
 	public:
 		hash_set() : rep(100, hasher(), key_equal()) { }
 		explicit hash_set(size_type n) : rep(n, hasher(), key_equal()) { }
 		hash_set(size_type n, const hasher& hf, const key_equal& eqk) : rep(n, hf, eqk) { }
 		hash_set(size_type n, const hasher& hf) : rep(n, hf, key_equal()) { }
+		template<class InputIterator>
+		hash_set(InputIterator first, InputIterator last) : rep(100, hasher(), key_equal()) { rep.insert_unique(first, last); }
 
 	public:
 		size_type size() const { return rep.size(); }
@@ -51,36 +55,59 @@ namespace TinySTL
 		iterator begin() const { return rep.begin(); }
 		iterator end() const { return rep.end(); }
 
-		void swap(const hash_set& hs) { rep.swap(hs.rep); }
+		void swap(hash_set& hs) { rep.swap(hs.rep); }
 		bool operator == (const hash_set& x) const { return rep.operator==(x.rep); }
 		bool operator != (const hash_set& x) const { return !(*this == x); }
 	public:
 		pair<iterator, bool> insert(const value_type& val)
 		{
-			pair<typename hashtable::iterator, bool> tmp = rep.insert_unique(val);
+			pair<typename ht::iterator, bool> tmp = rep.insert_unique(val);
 			return pair<iterator, bool>(tmp.first, tmp.second);
 		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { rep.insert_unique(first, last); }   // ֻһ
+		// codeΪõhashֵhash_funct()(key)ڶ֮临
+		pair<iterator, bool> insert(const value_type& val, size_type code) { return rep.insert_unique(val, code); }
 		iterator find(const key_type& key) const { return rep.find(key); }
+		iterator find(const key_type& key, size_type code) const { return rep.find(key, code); }
+		// HashfcnEqualkeyis_transparentʱüݵͲңstring_hashstring_equal
+		template<class K>
+		iterator find(const K& key) const { return rep.find(key); }
+		template<class K>
+		iterator find(const K& key, size_type code) const { return rep.find(key, code); }
+		template<class K>
+		size_type count(const K& key) const { return rep.count(key); }
+		template<class ForwardIterator, class OutputIterator>
+		OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator result) const
+			{ return rep.find_batch(first, last, result); }
 		size_type count(const key_type& key) const { return rep.count(key); }
 		void erase(iterator pos) { rep.erase(pos); }
 		void clear() { rep.clear(); }
 
 		void resize(size_type n) { rep.resize(n); }
-		size_type buckets_count() const { return buckets_count(); }	
+		void reserve(size_type n) { rep.reserve(n); }
+		void rehash(size_type n) { rep.rehash(n); }
+		void shrink_to_fit() { rep.shrink_to_fit(); }
+		void compact() { rep.compact(); }     // СbucketsѽڵؽڴУеʧЧ
+		float load_factor() const { return rep.load_factor(); }
+		float max_load_factor() const { return rep.max_load_factor(); }
+		void max_load_factor(float z) { rep.max_load_factor(z); }
+		void set_incremental_rehash(bool on) { rep.set_incremental_rehash(on); }   // ݵĴ۷̯֮Ĳ롢ɾ
+		size_type buckets_count() const { return rep.buckets_count(); }	
 	};
 
-	template<class Value, class Hashfcn, class Equalkey>
-	bool operator == (const hash_set<Value, Hashfcn, Equalkey>& lhs, const hash_set<Value, Hashfcn, Equalkey>& rhs)
+	template<class Value, class Hashfcn, class Equalkey, class RehashPolicy, bool CacheHash>
+	bool operator == (const hash_set<Value, Hashfcn, Equalkey, RehashPolicy, CacheHash>& lhs, const hash_set<Value, Hashfcn, Equalkey, RehashPolicy, CacheHash>& rhs)
 	{
 		return lhs.operator==(rhs);
 	}
-	template<class Value, class Hashfcn, class Equalkey>
-	bool operator != (const hash_set<Value, Hashfcn, Equalkey>& lhs, const hash_set<Value, Hashfcn, Equalkey>& rhs)
+	template<class Value, class Hashfcn, class Equalkey, class RehashPolicy, bool CacheHash>
+	bool operator != (const hash_set<Value, Hashfcn, Equalkey, RehashPolicy, CacheHash>& lhs, const hash_set<Value, Hashfcn, Equalkey, RehashPolicy, CacheHash>& rhs)
 	{
 		return lhs.operator!=(rhs);
 	}
-	template<class Value, class Hashfcn, class Equalkey>
-	void swap (hash_set<Value, Hashfcn, Equalkey>& lhs, hash_set<Value, Hashfcn, Equalkey>& rhs)
+	template<class Value, class Hashfcn, class Equalkey, class RehashPolicy, bool CacheHash>
+	void swap (hash_set<Value, Hashfcn, Equalkey, RehashPolicy, CacheHash>& lhs, hash_set<Value, Hashfcn, Equalkey, RehashPolicy, CacheHash>& rhs)
 	{
 		return lhs.swap(rhs);
 	}
@@ -12,25 +12,72 @@
 #include "Vector.h"
 #include "Iterator.h"
 #include "Algorithm.h"
+#include "./Detail/hash_functions.h"
+#include "./Detail/simd_functions.h"
 
 namespace TinySTL
 {
-   /*********************** strcut hashtable_node *****************************/
-	template<class T>
+	/*********************** rehash policy *****************************/
+	/*
+	*  rehash policy bucketsĸԼԪĸbucketΪhashtableģÿԵѡ
+	*  next_bkt(n)Сnbuckets    bucket_index(h, n)hashֵΪhԪnbucketsеλ
+	*/
+
+	// ĬϲԣbucketsȡȡģλÿζλҪһԽhashҲȽϿ
+	struct prime_rehash_policy
+	{
+		static size_t next_bkt(size_t n);
+		static size_t max_bkt_count();
+		static size_t bucket_index(size_t h, size_t n) { return h % n; }
+	};
+
+	// bucketsȡ2ݣhashֵȾhash_mix˷ + λϣfastrangeȡλλûг
+	// ûԶhashֱӷϵĻλλķֲܲ
+	struct pow2_rehash_policy
+	{
+		static size_t next_bkt(size_t n)
+		{
+			size_t ret = 16;
+			while (ret < n && ret < max_bkt_count())
+				ret <<= 1;
+			return ret;
+		}
+		static size_t max_bkt_count() { return static_cast<size_t>(1) << (sizeof(size_t) * 8 - 2); }
+		static size_t bucket_index(size_t h, size_t n) { return fastrange(hash_mix(h), n); }
+	};
+
+	/*********************** strcut hashtable_node *****************************/
+	template<class T, bool CacheHash = false>
 	struct hashtable_node
 	{
 		hashtable_node* next;
 		T val;
 	};
+	// CacheHashΪtrueʱڵжⱣhashֵ
+	// rehashǰʱٶkeyhashʱhashֵȵĽڵ㲻صequals
+	// keyΪstringhashȽ϶Ҫɨkeyʱԣÿڵһsize_t
+	template<class T>
+	struct hashtable_node<T, true>
+	{
+		hashtable_node* next;
+		size_t code;
+		T val;
+	};
+
+	template<bool CacheHash>
+	struct hashtable_cache_tag { };
+
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
+	class hashtable;
 
 	/*********************** strcut hashtable_iterator *****************************/
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc>
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy, bool CacheHash, class Alloc>
 	struct hashtable_iterator
 	{
-		typedef hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>  hashtable;
-		typedef hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc> iterator;
-		//typedef hashtable_const_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc> const_iterator;
-		typedef hashtable_node<Value> node;
+		typedef hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>  hashtable_type;
+		typedef hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc> iterator;
+		//typedef hashtable_const_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc> const_iterator;
+		typedef hashtable_node<Value, CacheHash> node;
 
 		typedef forward_iterator_tag  iterator_category;
 		typedef Value                 value_type;
@@ -40,25 +87,26 @@ namespace TinySTL
 		typedef Value*                pointer;
 
 		/* ݽṹ */
-		hashtable* ht;        // ӹϵhashfcnʼλ
 		node* cur;  // ǰָĽڵ
+		hashtable_type* ht;        // ӹϵhashfcnʼλ
 
 		hashtable_iterator() { }
-		hashtable_iterator(node* x, hashtable* y) : ht(y), cur(x) { }
+		hashtable_iterator(node* x, hashtable_type* y) : cur(x), ht(y) { }
 		reference operator * () const { return cur->val; }
 		pointer operator -> () const { return &(operator*()); }
 
 		iterator& operator ++ ();
 		iterator operator ++ (int);
 
-		bool operator == (const iterator& iter) const { return ht == iter.ht && cur == iter.cur; }
-		bool operator != (const iterator& iter) const { return !((*this) == iter); }
+		bool operator == (const iterator& iter) const { return cur == iter.cur; }
+		bool operator != (const iterator& iter) const { return cur != iter.cur; }
 
 	};
 
 	/************************* class hashtable **************************************/
 
-	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class Alloc = allocator<hashtable_node<Value>>>
+	template<class Value, class Key, class Hashfcn, class Extractkey, class Equalkey, class RehashPolicy = prime_rehash_policy,
+	         bool CacheHash = false, class Alloc = allocator<hashtable_node<Value, CacheHash>>>
 	class hashtable
 	{
 		/*
@@ -67,79 +115,175 @@ namespace TinySTL
 		*  Hashfcnhash functionsͱڼԪشŵλãº
 		*  Extractkeyӽڵȡkeyķº
 		*  Equalkeyڵkeyֵȵķº
+		*  RehashPolicybucketsѡȡԪضλĲԣprime_rehash_policypow2_rehash_policy
+		*  CacheHashڵǷ񱣴hashֵ
 		*  AllocڵĿռ
 		*/
 
+		friend struct hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>;
 
 	public:
-		typedef Hashfcn     hasher;
-		typedef Equalkey    key_equal;
-		typedef Value       value_type;
-		typedef Key         key_type;
-		typedef size_t      size_type;
-		typedef value_type& reference;
-		typedef hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc> iterator;
+		typedef Hashfcn       hasher;
+		typedef Equalkey      key_equal;
+		typedef RehashPolicy  rehash_policy;
+		typedef Value         value_type;
+		typedef Key           key_type;
+		typedef size_t        size_type;
+		typedef value_type&   reference;
+		typedef hashtable_iterator<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc> iterator;
 	private:
-		typedef hasher      hash;
-		typedef key_equal   equals;
-		typedef Extractkey  get_key;
-		
-
-		typedef hashtable_node<Value>  node;  // Ľڵ
-		typedef Alloc                  node_allocator;
+		typedef hashtable_node<Value, CacheHash>  node;  // Ľڵ
+		typedef Alloc                             node_allocator;
+		typedef hashtable_cache_tag<CacheHash>    cache_tag;
 
-		typedef hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>  self
+		typedef hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, RehashPolicy, CacheHash, Alloc>  self;
 
 		// hashtableݽṹ
+		hasher hash;
+		key_equal equals;
+		Extractkey get_key;
 		vector<node*> buckets;
 		size_type num_elems;
+		// ڽʽrehashʱһΰ꣬ɵbucketsʱold_bucketsУ
+		// ֮ÿβ롢ɾ˳rehash_batchbucket֮ͷold_buckets
+		// ڼ䣬һԪҪôold_bucketsУҪôbucketsУʱ߶Ҫ
+		vector<node*> old_buckets;
+		size_type migrate_pos;      // old_buckets[0, migrate_pos)Ѿ
+		bool incremental;           // ǷʹýʽrehashĬϹر
+		float max_load;             // װʣԪظ / bucketsĬΪ1
+		size_type next_resize;      // Ԫظʱݣbuckets * max_load
+		// compact()нڵؽһڴ棨arenaarenaеĽڵɾʱֻͷţ
+		// arenaеĽڵȫɾٴcompactʱͷ
+		node* arena;
+		size_type arena_size;
+		size_type arena_live;       // arenaлʹõĽڵ
+
+		static const size_type rehash_batch = 8;
+		static const size_type batch_size = 16;     // find_batchÿδkey
 
-		// Ϊ28ڸbucketsС
-	   
-		static const int buckets_prime_nums;
-		static const unsigned long buckets_num_list[buckets_prime_nums];
-		
 	public:
 		// 캯ṩĬϹ캯
-		hashtable(size_type n, const Hashfcn& hf, const Equalkey& eql) 
-			:hasher(hf), key_equal(eql), get_key(Extractkey()), num_elems(0) 
+		hashtable(size_type n, const Hashfcn& hf, const Equalkey& eql)
+			: hash(hf), equals(eql), get_key(Extractkey()), num_elems(0), migrate_pos(0), incremental(false),
+			  max_load(1.0f), next_resize(0), arena(nullptr), arena_size(0), arena_live(0)
 			{ init_buckets(n); }
+		hashtable(const self& x)
+			: hash(x.hash), equals(x.equals), get_key(x.get_key), num_elems(0), migrate_pos(0), incremental(x.incremental),
+			  max_load(x.max_load), next_resize(0), arena(nullptr), arena_size(0), arena_live(0)
+			{ copy_from(x); }
 		~hashtable();
 
-		self& operator = (const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x);
-		
+		self& operator = (const self& x);
+
 		pair<iterator, bool> insert_unique(const value_type& val);
 		iterator insert_equal(const value_type& val);
-		void erase(iterator pos);
+		// codeΪõhashֵhasher()(key)ͬһhashֵڶβ֮临
+		pair<iterator, bool> insert_unique(const value_type& val, size_type code);
+		iterator insert_equal(const value_type& val, size_type code);
+		// һ䣬forward iteratorԪظֻһ
+		template<class InputIterator>
+		void insert_unique(InputIterator first, InputIterator last) { insert_unique_range(first, last, iterator_category(first)); }
+		template<class InputIterator>
+		void insert_equal(InputIterator first, InputIterator last) { insert_equal_range(first, last, iterator_category(first)); }
+		void erase(iterator pos) { erase(pos, node_code(pos.cur)); }
+		void erase(iterator pos, size_type code);    // codeΪ*poskeyhashֵ
 		void clear();
-		void copy_from(const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& ht);
-		void swap(hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x);
-		iterator find(const key_type& key);
-		size_type count(const key_type& key) const;
-		
+		void copy_from(const self& ht);
+		void swap(self& x);
+		iterator find(const key_type& key) const { return iterator(find_node(key, hash(key)), const_cast<self*>(this)); }
+		iterator find(const key_type& key, size_type code) const { return iterator(find_node(key, code), const_cast<self*>(this)); }
+		size_type count(const key_type& key) const { return count_key(key, hash(key)); }
+
+		// 칹ңHashfcnEqualkeyis_transparentʱֱkey_typeݵͲ
+		// keyΪstringʱconst char*string_viewңҪȹһstring
+		// ͵hashֵӦkey_typeͬҴbucket
+		template<class K, class H = Hashfcn, class E = Equalkey, class = typename H::is_transparent, class = typename E::is_transparent>
+		iterator find(const K& key) const { return iterator(find_node(key, hash(key)), const_cast<self*>(this)); }
+		template<class K, class H = Hashfcn, class E = Equalkey, class = typename H::is_transparent, class = typename E::is_transparent>
+		iterator find(const K& key, size_type code) const { return iterator(find_node(key, code), const_cast<self*>(this)); }
+		template<class K, class H = Hashfcn, class E = Equalkey, class = typename H::is_transparent, class = typename E::is_transparent>
+		size_type count(const K& key) const { return count_key(key, hash(key)); }
+		// [first, last)еÿkeyҲʱΪend()дresultд֮result
+		// ÿȡbatch_sizekeyȫhashԤȡbucketԤȡͷڵ㣬űȽ
+		// keycache missصһٲһ
+		template<class ForwardIterator, class OutputIterator>
+		OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator result) const;
+
 		iterator begin() const;
-		iterator end() const;
+		iterator end() const { return iterator(nullptr, const_cast<self*>(this)); }
 
-		bool operator == (const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x) const;
-		bool operator != (const hashtable<Value, Key, Hashfcn, Extractkey, Equalkey, Alloc>& x) const;
+		bool operator == (const self& x) const;
+		bool operator != (const self& x) const;
 
 		size_type size() const { return num_elems; }
 		size_type buckets_count() const { return buckets.size(); }
+		// º  hashtableõbucketsǲsizeŶ
+		size_type max_buckets_count() const { return rehash_policy::max_bkt_count(); }
+
+		void resize(size_type n);    // жϷnԪʱ費ҪؽbucketsҪĻؽ
+		void reserve(size_type n) { resize(n); }
+		void rehash(size_type n);    // bucketsؽΪСnmax_loadԱС
+		void shrink_to_fit() { rehash(0); }   // ɾ֮󣬰ǰԪظbucketsС
+		// shrink_to_fitٰнڵ㰴bucket˳ؽһڴУ֮ıҶ
+		// ڵᱻµλã֮ǰĵָ롢ȫʧЧ
+		void compact();
+
+		float load_factor() const { return static_cast<float>(num_elems) / buckets.size(); }
+		float max_load_factor() const { return max_load; }
+		void max_load_factor(float z);    // z <= 0NaNʱ
+
+		// 򿪺ݵĴ۷̯֮Ĳ롢ɾУβʱԪظ
+		void set_incremental_rehash(bool on) { incremental = on; }
+		bool is_rehashing() const { return !old_buckets.empty(); }
+		void finish_rehash();        // еľbucket
 
 	private:
-		unsigned long next_prime_num(size_type n);  // ڲʹãbuckets_num_listдnĵһ
-		// º  hashtableõbucketsǲsizeŶ
-		unsigned long max_buckets_count() const { return buckets_num_list[buckets_prime_nums - 1]; }
-		node* new_node();   // 䲢һnodeڵ
+		node* new_node(const value_type& val, size_type code);   // 䲢һnodeڵ㣬codeΪvalhashֵ
 		void destroy_node(node* ptr);  // valueջnodeռ
 		void init_buckets(size_type n); //ʼbucketsvector
-		void resize(size_type n);    // ж費ҪؽbucketsҪĻؽ
-		pair<iterator, bool> insert_unique_noresize(const value_type& val);  
-		iterator insert_equal_noresize(const value_type& val);
-		size_type bkt_num(const value_type& val, size_type n); // hashõԪصλ
-		size_type bkt_num(const value_type& val);
-		size_type bkt_num_key(const key_type& key);
-		size_type bkt_num_key(const key_type& key, size_type n);
+		void rebuild_buckets(size_type new_n);   // нڵһΰᵽnew_nbuckets
+		void update_next_resize() { next_resize = static_cast<size_type>(buckets.size() * max_load); }
+		size_type bkt_for(size_type n) const { return static_cast<size_type>(n / max_load) + 1; }   // nԪҪbuckets
+		void release_arena();
+		pair<iterator, bool> insert_unique_noresize(const value_type& val, size_type code);
+		iterator insert_equal_noresize(const value_type& val, size_type code);
+		template<class InputIterator>
+		void insert_unique_range(InputIterator first, InputIterator last, input_iterator_tag);
+		template<class ForwardIterator>
+		void insert_unique_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+		template<class InputIterator>
+		void insert_equal_range(InputIterator first, InputIterator last, input_iterator_tag);
+		template<class ForwardIterator>
+		void insert_equal_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+		template<class ForwardIterator>
+		size_type range_length(ForwardIterator first, ForwardIterator last);
+		size_type bkt_num(const value_type& val, size_type n) const; // hashõԪصλ
+		size_type bkt_num(const value_type& val) const;
+		size_type bkt_num_key(const key_type& key) const;
+		size_type bkt_num_key(const key_type& key, size_type n) const;
+		size_type bkt_num_code(size_type code, size_type n) const { return rehash_policy::bucket_index(code, n); }
+		size_type node_bkt(const node* x, size_type n) const { return bkt_num_code(node_code(x), n); }
+
+		// ڵhashֵCacheHashʱֱӶ¼
+		size_type node_code(const node* x) const { return node_code(x, cache_tag()); }
+		size_type node_code(const node* x, hashtable_cache_tag<true>) const { return x->code; }
+		size_type node_code(const node* x, hashtable_cache_tag<false>) const { return hash(get_key(x->val)); }
+		// Ƚkey֮ǰȱȽhashֵûбhashֵʱǷtrue
+		bool code_match(const node* x, size_type code) const { return code_match(x, code, cache_tag()); }
+		bool code_match(const node* x, size_type code, hashtable_cache_tag<true>) const { return x->code == code; }
+		bool code_match(const node*, size_type, hashtable_cache_tag<false>) const { return true; }
+		void set_code(node* x, size_type code, hashtable_cache_tag<true>) { x->code = code; }
+		void set_code(node*, size_type, hashtable_cache_tag<false>) { }
+		template<class K>
+		node* find_node(const K& key, size_type code) const;
+		template<class K>
+		size_type count_key(const K& key, size_type code) const;
+		node* next_node(const node* x) const;      // ʹãxΪһڵʱһڵ
+		void migrate_buckets(size_type count);     // migrate_posʼcountbucketȫͷold_buckets
+		void migrate_bucket(size_type i);          // old_buckets[i]еĽڵȫᵽbuckets
+		bool unlink_node(vector<node*>& bkts, size_type n, node* x);   // bkts[n]Ŀժxʱfalse
+		void migrate_code(size_type code);         // ȰhashֵΪcodekeyڵľbucketֻ֮꣬Ҫbuckets
+		size_type count_value(const value_type& val) const;
 	};
 
 
@@ -149,4 +293,3 @@ namespace TinySTL
 #include "Detail\Hashtable.impl.h"
 
 #endif // !_HASHTABLE_H_
-
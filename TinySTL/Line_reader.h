@@ -0,0 +1,119 @@
+#ifndef _LINE_READER_H_
+#define _LINE_READER_H_
+
+/*
+*	Author  @yyehl
+*/
+
+#include "Allocator.h"
+#include "String_view.h"
+#include "./Detail/simd_functions.h"
+
+/*
+*  line_reader：按行读取文件，每一行以string_view的形式返回，不复制，不为每行分配内存
+*  两种工作方式：
+*  1. line_reader(fd)   ：从文件描述符中分块read()到一个可重复使用的缓冲区里，
+*                         返回的string_view指向缓冲区，下一次调用next_line()之后失效
+*                         不负责关闭fd
+*  2. line_reader(path) ：把整个文件mmap进来（只读），返回的string_view在reader析构前一直有效
+*                         不支持mmap的平台上自动退回到方式1
+*  行尾的'\n'不包含在返回的行中，文件最后一行没有'\n'时也会返回
+*
+*  tokenizer：把一行按分隔符切分成若干字段，同样只返回string_view
+*/
+
+namespace TinySTL
+{
+	/*********************** class line_reader *****************************/
+	class line_reader
+	{
+	public:
+		typedef size_t   size_type;
+
+	private:
+		typedef allocator<char>   data_allocator;
+
+		// 以下是line_reader的数据结构
+		int fd;                  // 读取的文件描述符，-1表示没有
+		bool own_fd;             // 是否由line_reader自己打开，需要自己关闭
+		bool mapped;             // 是否为mmap方式
+		char* buf;               // 缓冲区（mmap方式下为映射的起始地址）
+		size_type buf_size;      // 缓冲区（或映射）的大小
+		const char* cur;         // 下一行的起始位置
+		const char* last;        // 有效数据的末尾
+		bool eof;                // fd是否已经读完
+		bool ok;                 // 打开或读取是否出错
+		size_type lines;         // 已经返回的行数
+
+	public:
+		explicit line_reader(int file, size_type buffer_size = 64 * 1024);
+		explicit line_reader(const char* path);
+		~line_reader();
+
+		// 读取下一行，没有更多的行时返回false
+		bool next_line(string_view& line);
+
+		bool good() const { return ok; }
+		size_type line_number() const { return lines; }
+
+	private:
+		line_reader(const line_reader&);              // 持有文件和缓冲区，不允许复制
+		line_reader& operator = (const line_reader&);
+
+		void init_buffer(size_type n);
+		bool map_file();         // 对fd建立只读映射，失败时返回false
+		bool fill();             // 把未处理完的数据移到缓冲区头部，再读入新数据
+	};
+
+	/*********************** class tokenizer *****************************/
+	class tokenizer
+	{
+	private:
+		const char* cur;
+		const char* last;
+		char delim;
+		bool done;
+
+	public:
+		tokenizer(const string_view& line, char d) : cur(line.begin()), last(line.end()), delim(d), done(false) { }
+
+		// 取出下一个字段，字段可以为空（两个相邻的分隔符之间）；没有更多字段时返回false
+		bool next(string_view& field)
+		{
+			if (done)
+				return false;
+			const char* pos = simd_find_byte(cur, last, delim);
+			field = string_view(cur, pos);
+			if (pos == last)
+				done = true;
+			else
+				cur = pos + 1;
+			return true;
+		}
+	};
+
+	// 把line切分后写入fields，最多写max_fields个，返回写入的字段数
+	// 字段数超过max_fields时，最后一个字段包含剩下的全部内容
+	inline size_t split(const string_view& line, char delim, string_view* fields, size_t max_fields)
+	{
+		if (max_fields == 0)
+			return 0;
+		const char* cur = line.begin();
+		const char* last = line.end();
+		size_t n = 0;
+		while (n + 1 < max_fields)
+		{
+			const char* pos = simd_find_byte(cur, last, delim);
+			fields[n++] = string_view(cur, pos);
+			if (pos == last)
+				return n;
+			cur = pos + 1;
+		}
+		fields[n++] = string_view(cur, last);
+		return n;
+	}
+
+}  // namespace TinySTL
+
+
+#endif // !_LINE_READER_H_
@@ -8,23 +8,25 @@
 #include "RB_tree.h"
 #include "Functional.h"
 
+// OrderStatΪtrueʱranknthdistanceΪO(logN)ÿڵһsize_t
 
 namespace TinySTL
 {
-	template<class Key, class T, class Compare = less<Key>>
+	template<class Key, class T, class Compare = less<Key>, bool OrderStat = false>
 	class map
 	{
 	public:
-		typedef Key              key_type;
-		typedef T                data_type;
-		typedef pair<Key, T>     value_type;
-		typedef T                mapped_type;
-		typedef Compare          key_compare;
+		typedef Key                    key_type;
+		typedef T                      data_type;
+		typedef pair<const Key, T>     value_type;
+		typedef T                      mapped_type;
+		typedef Compare                key_compare;
 
 	private:
-		typedef rb_tree<key_type, value_type, selece1st<value_type>, key_compare> rep_type;
+		typedef rb_tree<key_type, value_type, select1st<value_type>, key_compare, OrderStat> rep_type;
 		rep_type t;   // ײݽṹ  rb_tree
 
+	public:
 		typedef typename rep_type::iterator            iterator;
 		typedef typename rep_type::const_iterator      const_iterator;
 		typedef typename rep_type::pointer             pointer;
@@ -33,50 +35,89 @@ namespace TinySTL
 		typedef typename rep_type::const_reference     const_reference;
 		typedef typename rep_type::size_type           size_type;
 		typedef typename rep_type::difference_type     difference_type;
+		typedef typename rep_type::node_type          node_type;
+		typedef typename rep_type::range_type         range_type;
+		typedef typename rep_type::const_range_type   const_range_type;
 
 	public:
 		map() : t(key_compare()) { }
 		explicit map(const Compare& cmp) : t(cmp) { }
-		map(const map<key_type, data_type, Compare>& x) : t(x.t) { }
+		map(const map& x) : t(x.t) { }
+		template<class InputIterator>
+		map(InputIterator first, InputIterator last) : t(key_compare()) { t.insert_unique(first, last); }   // ΪO(N)
 
-		map<Key, T, Compare>& operator = (const map<Key, T, Compare>& x) { t = x.t; return *this; }
+		map& operator = (const map& x) { t = x.t; return *this; }
 
 		key_compare key_comp() const { return t.key_comp(); }
-		iterator begin() const { return t.begin(); }
-		iterator end() const { return t.end(); }
+		iterator begin() { return t.begin(); }
+		iterator end() { return t.end(); }
+		const_iterator begin() const { return t.begin(); }
+		const_iterator end() const { return t.end(); }
 		bool empty() const { return t.empty(); }
 		size_type size() const { return t.size(); }
 		size_type max_size() const { return t.max_size(); }
-		void swap(map<Key, T, Compare>& x) { t.swap(x.t); }
+		void swap(map& x) { t.swap(x.t); }
+
+		// 㣬*thisУxգxĽڵֱӲ*this٣mΪСһĴСΪO(mlog(n/m + 1))
+		void set_union(map& x) { t.set_union(x.t); }
+		void set_intersection(map& x) { t.set_intersection(x.t); }
+		void set_difference(map& x) { t.set_difference(x.t); }
 
 		T& operator [] (const key_type& k) { return (*((insert(value_type(k, T()))).first)).second; }
 
 		pair<iterator, bool> insert(const value_type& x) { return t.insert_unique(x); }
+		iterator insert(iterator hint, const value_type& x) { return t.insert_unique(hint, x); }   // hintλʱΪ̯O(1)end()Ϊhint׷ӵļ
+		template<class... Args>
+		pair<iterator, bool> emplace(Args&&... args) { return t.emplace_unique(std::forward<Args>(args)...); }
+		template<class... Args>
+		iterator emplace_hint(iterator hint, Args&&... args) { return t.emplace_hint_unique(hint, std::forward<Args>(args)...); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_unique(first, last); }
 		void erase(iterator pos) { t.erase(pos); }
+		size_type erase(const key_type& k) { return t.erase(k); }
+		node_type extract(iterator pos) { return t.extract(pos); }   // ȡڵ㣬
+		node_type extract(const key_type& k) { return t.extract(k); }
+		pair<iterator, bool> insert(node_type&& nh) { return t.insert_unique(std::move(nh)); }   // ֱnhеĽڵ㣻ֵѴʱڵnh
+		void merge(map& x) { t.merge_unique(x.t); }   // xĽڵתƹ*thisеļֵx
 		void clear() { t.clear(); }
-		iterator find(const key_type& k) const { return t.find(k); }
-
-		bool operator == (const map<Key, T, Compare>& y) const
+		iterator find(const key_type& k) { return t.find(k); }
+		const_iterator find(const key_type& k) const { return t.find(k); }
+		size_type count(const key_type& k) const { return t.count(k); }
+
+		// ѯrange(lo, hi)Ϊ[lo, hi)ͼʱǰcount_rangeOrderStatΪtrueʱΪO(logN)
+		iterator lower_bound(const key_type& k) { return t.lower_bound(k); }
+		iterator upper_bound(const key_type& k) { return t.upper_bound(k); }
+		const_iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+		const_iterator upper_bound(const key_type& k) const { return t.upper_bound(k); }
+		pair<iterator, iterator> equal_range(const key_type& k) { return t.equal_range(k); }
+		pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return t.equal_range(k); }
+		range_type range(const key_type& lo, const key_type& hi) { return t.range(lo, hi); }
+		const_range_type range(const key_type& lo, const key_type& hi) const { return t.range(lo, hi); }
+		size_type count_range(const key_type& lo, const key_type& hi) const { return t.count_range(lo, hi); }
+
+		// ˳ͳƣrankΪСkԪظnthΪnԪأ0ʼdistanceΪ֮Ԫظ
+		size_type rank(const key_type& k) const { return t.rank(k); }
+		iterator nth(size_type n) { return t.nth(n); }
+		const_iterator nth(size_type n) const { return t.nth(n); }
+		difference_type distance(const_iterator first, const_iterator last) const { return t.distance(first, last); }
+
+		bool operator == (const map& y) const
 		{
 			return t == y.t;
 		}
-		bool operator != (const map<Key, T, Compare>& y) const
+		bool operator != (const map& y) const
 		{
 			return !(t == y.t);
 		}
-
-		friend bool operator == <> (const map<Key, T, Compare>& x, const map<Key, T, Compare>& y);
-		friend bool operator != <> (const map<Key, T, Compare>& x, const map<Key, T, Compare>& y);
-
 	};
 
-	template<class Key, class T, class Compare>
-	bool operator == (const map<Key, T, Compare>& x, const map<Key, T, Compare>& y)
+	template<class Key, class T, class Compare, bool OrderStat>
+	bool operator == (const map<Key, T, Compare, OrderStat>& x, const map<Key, T, Compare, OrderStat>& y)
 	{
 		return x.operator==(y);
 	}
-	template<class Key, class T, class Compare>
-	bool operator != (const map<Key, T, Compare>& x, const map<Key, T, Compare>& y)
+	template<class Key, class T, class Compare, bool OrderStat>
+	bool operator != (const map<Key, T, Compare, OrderStat>& x, const map<Key, T, Compare, OrderStat>& y)
 	{
 		return x.operator!=(y);
 	}
@@ -89,4 +130,3 @@ namespace TinySTL
 
 
 #endif // !_MAP_H_
-
@@ -8,11 +8,12 @@
 #include "RB_tree.h"
 #include "Functional.h"
 
-// ʣ setkeyvaluesetsetظsetͨ޸ֵ
+// ʣ multisetkeyvaluemultisetظͨ޸ֵ
+// OrderStatΪtrueʱranknthdistanceΪO(logN)ÿڵһsize_t
 
 namespace TinySTL
 {
-	template<class Key, class Compare = less<Key>>
+	template<class Key, class Compare = less<Key>, bool OrderStat = false>
 	class multiset
 	{
 	public:
@@ -22,7 +23,7 @@ namespace TinySTL
 		typedef Compare  value_compare;
 
 	private:
-		typedef rb_tree<Key, Key, identity<Key>, Compare>     rep_type;
+		typedef rb_tree<Key, Key, identity<Key>, Compare, OrderStat>     rep_type;
 
 		rep_type t;   // setݽṹõrb_tree
 	public:
@@ -30,20 +31,25 @@ namespace TinySTL
 		typedef typename rep_type::const_iterator     const_iterator;
 		typedef typename rep_type::const_pointer      pointer;
 		typedef typename rep_type::const_pointer      const_pointer;
-		typedef typename rep_type::const_reference    cosnt_reference;
+		typedef typename rep_type::const_reference    const_reference;
 		typedef typename rep_type::const_reference    reference;
 
 		typedef typename rep_type::size_type          size_type;
 		typedef typename rep_type::difference_type    difference_type;
+		typedef typename rep_type::node_type          node_type;
+		typedef typename rep_type::const_range_type   range_type;
+		typedef typename rep_type::const_range_type   const_range_type;
 	private:
 		typedef typename rep_type::iterator           rep_iterator;
 
 	public:
 		multiset() : t(Compare()) { }
 		explicit multiset(const Compare& cmp) : t(cmp) { }
-		multiset(const multiset<Key, Compare>& x) : t(x.t) { }
+		multiset(const multiset& x) : t(x.t) { }
+		template<class InputIterator>
+		multiset(InputIterator first, InputIterator last) : t(Compare()) { t.insert_equal(first, last); }   // ΪO(N)
 
-		multiset<Key, Compare>& operator=(const multiset<Key, Compare>& x) { t = x.t; return *this; }
+		multiset& operator=(const multiset& x) { t = x.t; return *this; }
 
 		key_compare key_comp() const { return t.key_comp(); }
 		value_compare value_comp() const { return t.key_comp(); }
@@ -52,39 +58,55 @@ namespace TinySTL
 		bool empty() const { return t.empty(); }
 		size_type size() const { return t.size(); }
 		size_type max_size() const { return t.max_size(); }
-		void swap(multiset<Key, Compare>& x) { t.swap(x.t); }
-
-		pair<iterator, bool> insert(const value_type& val)
-		{
-			pair<rep_iterator, bool> p = t.insert_equal(val);
-			return pair<iterator, bool>(p.first, p.second);
-		}
-		void erase(iterator pos) { return t.erase(rep_iterator(pos.node)); }
-		void clear() { return t.clear(); }
-
-		iterator find(const value_type& val) const { return t.find(val); }
-
-		bool operator == (const multiset<Key, Compare>& y) const
+		void swap(multiset& x) { t.swap(x.t); }
+
+		iterator insert(const value_type& val) { return t.insert_equal(val); }
+		iterator insert(iterator hint, const value_type& val) { return t.insert_equal(rep_iterator(hint.node), val); }   // hintλʱΪ̯O(1)
+		template<class... Args>
+		iterator emplace(Args&&... args) { return t.emplace_equal(std::forward<Args>(args)...); }
+		template<class... Args>
+		iterator emplace_hint(iterator hint, Args&&... args) { return t.emplace_hint_equal(rep_iterator(hint.node), std::forward<Args>(args)...); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_equal(first, last); }
+		void erase(iterator pos) { t.erase(rep_iterator(pos.node)); }
+		size_type erase(const key_type& key) { return t.erase(key); }
+		node_type extract(iterator pos) { return t.extract(rep_iterator(pos.node)); }   // ȡڵ㣬
+		node_type extract(const key_type& key) { return t.extract(key); }
+		iterator insert(node_type&& nh) { return t.insert_equal(std::move(nh)); }   // ֱnhеĽڵ
+		void merge(multiset& x) { t.merge_equal(x.t); }   // xĽڵתƹ
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& key) const { return t.find(key); }
+		size_type count(const key_type& key) const { return t.count(key); }
+
+		// ѯrange(lo, hi)Ϊ[lo, hi)ͼʱǰcount_rangeOrderStatΪtrueʱΪO(logN)
+		iterator lower_bound(const key_type& key) const { return t.lower_bound(key); }
+		iterator upper_bound(const key_type& key) const { return t.upper_bound(key); }
+		pair<iterator, iterator> equal_range(const key_type& key) const { return t.equal_range(key); }
+		range_type range(const key_type& lo, const key_type& hi) const { return t.range(lo, hi); }
+		size_type count_range(const key_type& lo, const key_type& hi) const { return t.count_range(lo, hi); }
+
+		size_type rank(const key_type& key) const { return t.rank(key); }
+		iterator nth(size_type n) const { return t.nth(n); }
+		difference_type distance(iterator first, iterator last) const { return t.distance(first, last); }
+
+		bool operator == (const multiset& y) const
 		{
 			return t == y.t;
 		}
-		bool operator != (const multiset<Key, Compare>& y) const
+		bool operator != (const multiset& y) const
 		{
 			return !(t == y.t);
 		}
+	};  // end of class multiset;
 
-		friend bool operator == <> (const multiset<Key, Compare>& x, const multiset<Key, Compare>& y);
-		friend bool operator != <> (const multiset<Key, Compare>& x, const multiset<Key, Compare>& y);
-
-	};  // end of class set;
-
-	template<class Key, class Compare>
-	bool operator == (const multiset<Key, Compare>& x, const multiset<Key, Compare>& y)
+	template<class Key, class Compare, bool OrderStat>
+	bool operator == (const multiset<Key, Compare, OrderStat>& x, const multiset<Key, Compare, OrderStat>& y)
 	{
 		return x.operator==(y);
 	}
-	template<class Key, class Compare>
-	bool operator != (const multiset<Key, Compare>& x, const multiset<Key, Compare>& y)
+	template<class Key, class Compare, bool OrderStat>
+	bool operator != (const multiset<Key, Compare, OrderStat>& x, const multiset<Key, Compare, OrderStat>& y)
 	{
 		return x.operator!=(y);
 	}
@@ -92,4 +114,4 @@ namespace TinySTL
 }   // namespace TinySTL
 
 
-#endif // !_MULTISET_H_
\ No newline at end of file
+#endif // !_MULTISET_H_
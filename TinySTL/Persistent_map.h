@@ -0,0 +1,244 @@
+#ifndef _PERSISTENT_MAP_H_
+#define _PERSISTENT_MAP_H_
+
+/*
+*  Author @yyehl
+*/
+
+#include <atomic>
+#include <new>
+
+#include "Iterator.h"
+#include "Functional.h"
+#include "Utility.h"
+#include "Construct.h"
+
+/*
+*  persistent_map 是持久化（结构共享）的有序map，底层为左倾红黑树（left-leaning red-black tree）
+*
+*  节点带引用计数，复制一个persistent_map只是让根节点的引用计数加一，snapshot()就是这样一次复制，为O(1)
+*  修改时只复制从根到修改位置路径上的节点（path copying），以及调整时要改颜色、旋转的兄弟节点，每次O(logN)个新节点，
+*  其余节点仍由新旧两个版本共享；左倾红黑树的插入、删除都可以写成不带parent指针的递归，正好适合路径复制
+*  节点的引用计数为1时说明只有当前这个版本能访问到它，直接就地修改，没有快照时修改不会分配多余的节点
+*
+*  多线程：同一个persistent_map对象不能在多个线程中同时修改，但不同的对象（比如写线程的map和读线程拿到的快照）
+*  可以在不同线程中同时使用，读者从不阻塞写者；共享的节点不会再被修改，引用计数为原子变量，最后一个引用释放时回收节点
+*  节点用::operator new分配，不经过alloc（alloc虽然加了锁，但所有线程共用一把）
+*
+*  迭代器只读，内部用一个栈保存还没访问到的祖先；迭代器、find返回的指针在这个版本被修改或析构之前有效，
+*  需要长期持有时先snapshot()
+*/
+
+namespace TinySTL
+{
+	/*********************** class persistent_rb_node *****************************/
+	template<class Value>
+	struct persistent_rb_node
+	{
+		std::atomic<size_t> refs;     // 指向它的父节点（或根）的个数
+		persistent_rb_node* left;
+		persistent_rb_node* right;
+		bool red;
+		Value value;
+	};
+
+	/*********************** class persistent_rb_iterator *****************************/
+	template<class Value>
+	struct persistent_rb_iterator
+	{
+		typedef forward_iterator_tag       iterator_category;
+		typedef Value                      value_type;
+		typedef const Value&               reference;
+		typedef const Value*               pointer;
+		typedef size_t                     size_type;
+		typedef ptrdiff_t                  difference_type;
+
+		typedef persistent_rb_iterator<Value>    self;
+		typedef persistent_rb_node<Value>        node;
+
+		static const int max_depth = 96;      // 左倾红黑树的高度不超过2log(N)，96层足够
+
+		const node* stack[max_depth];   // 栈顶为当前节点，其余为还没访问到的祖先（从它们的左子树下来的）
+		int depth;
+
+		persistent_rb_iterator() : depth(0) { }
+
+		reference operator * () const { return stack[depth - 1]->value; }
+		pointer operator -> () const { return &(operator*()); }
+
+		self& operator ++ () { increase(); return *this; }
+		self operator ++ (int) { self tmp = *this; ++(*this); return tmp; }
+
+		bool operator == (const self& x) const { return depth == x.depth && (depth == 0 || stack[depth - 1] == x.stack[x.depth - 1]); }
+		bool operator != (const self& x) const { return !(*this == x); }
+
+		void push_left(const node* x)    // x及其一路向左的节点入栈
+		{
+			for (; x != nullptr; x = x->left)
+				stack[depth++] = x;
+		}
+		void increase()
+		{
+			const node* x = stack[--depth];
+			push_left(x->right);
+		}
+	};
+
+	/*********************** class persistent_rb_tree *****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	class persistent_rb_tree
+	{
+	public:
+		typedef Key                                 key_type;
+		typedef Value                               value_type;
+		typedef Compare                             key_compare;
+		typedef const value_type*                   const_pointer;
+		typedef const value_type&                   const_reference;
+		typedef size_t                              size_type;
+		typedef ptrdiff_t                           difference_type;
+		typedef persistent_rb_iterator<Value>       const_iterator;
+		typedef const_iterator                      iterator;       // 只读
+
+	private:
+		typedef persistent_rb_node<Value>           node;
+		typedef persistent_rb_tree<Key, Value, KeyOfValue, Compare>  self;
+
+		node* root;
+		size_type node_count;
+		Compare comp;
+
+	public:
+		explicit persistent_rb_tree(const Compare& cmp = Compare()) : root(nullptr), node_count(0), comp(cmp) { }
+		persistent_rb_tree(const self& x) : root(retain(x.root)), node_count(x.node_count), comp(x.comp) { }   // O(1)，与x共享所有节点
+		persistent_rb_tree(self&& x) : root(x.root), node_count(x.node_count), comp(x.comp) { x.root = nullptr; x.node_count = 0; }
+		~persistent_rb_tree() { release(root); }
+
+		self& operator = (const self& x)
+		{
+			node* old = root;
+			root = retain(x.root);
+			node_count = x.node_count;
+			comp = x.comp;
+			release(old);
+			return *this;
+		}
+		self& operator = (self&& x)
+		{
+			if (this != &x)
+			{
+				release(root);
+				root = x.root;
+				node_count = x.node_count;
+				comp = x.comp;
+				x.root = nullptr;
+				x.node_count = 0;
+			}
+			return *this;
+		}
+
+		key_compare key_comp() const { return comp; }
+		const_iterator begin() const { const_iterator it; it.push_left(root); return it; }
+		const_iterator end() const { return const_iterator(); }
+		bool empty() const { return node_count == 0; }
+		size_type size() const { return node_count; }
+		size_type max_size() const { return size_type(-1); }
+		void swap(self& x);
+
+		const_iterator find(const key_type& k) const;
+		const_iterator lower_bound(const key_type& k) const;
+		size_type count(const key_type& k) const { return find_node(k) != nullptr ? 1 : 0; }
+		const value_type* find_value(const key_type& k) const { const node* x = find_node(k); return x == nullptr ? nullptr : &x->value; }
+
+		bool insert_unique(const value_type& val);       // 已经存在时不插入，返回false
+		bool insert_or_assign(const value_type& val);    // 已经存在时替换，返回是否为新插入
+		size_type erase(const key_type& k);              // 返回删除的元素个数（0或1）
+		void clear() { release(root); root = nullptr; node_count = 0; }
+
+	private:
+		static const key_type& key(const node* x) { return KeyOfValue()(x->value); }
+		static bool is_red(const node* x) { return x != nullptr && x->red; }
+		static node* create_node(const value_type& val, bool red);
+		static node* retain(node* x) { if (x != nullptr) x->refs.fetch_add(1, std::memory_order_relaxed); return x; }
+		static void release(node* x);
+		static node* mut(node* x);
+
+		const node* find_node(const key_type& k) const;
+
+		/* 以下函数的参数h都已经由mut取得（只有当前版本能访问到），返回调整后的子树的根 */
+		static node* rotate_left(node* h);
+		static node* rotate_right(node* h);
+		static void flip_colors(node* h);
+		static node* move_red_left(node* h);
+		static node* move_red_right(node* h);
+		static node* balance(node* h);
+
+		node* _insert(node* h, const value_type& val, bool& inserted);   // 已存在时替换
+		node* _erase(node* h, const key_type& k);                         // k一定存在
+		static node* _erase_min(node* h, node*& m);                       // 摘下最小的节点m，不销毁
+	};
+
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	inline void swap(persistent_rb_tree<Key, Value, KeyOfValue, Compare>& x, persistent_rb_tree<Key, Value, KeyOfValue, Compare>& y)
+	{
+		x.swap(y);
+	}
+
+	/*********************** class persistent_map *****************************/
+	template<class Key, class T, class Compare = less<Key>>
+	class persistent_map
+	{
+	private:
+		typedef persistent_rb_tree<Key, pair<const Key, T>, select1st<pair<const Key, T>>, Compare>  rep_type;
+		rep_type t;
+
+	public:
+		typedef Key                                    key_type;
+		typedef T                                      data_type;
+		typedef T                                      mapped_type;
+		typedef typename rep_type::value_type          value_type;
+		typedef Compare                                key_compare;
+		typedef typename rep_type::const_iterator      iterator;
+		typedef typename rep_type::const_iterator      const_iterator;
+		typedef typename rep_type::const_pointer       const_pointer;
+		typedef typename rep_type::const_reference     const_reference;
+		typedef typename rep_type::size_type           size_type;
+		typedef typename rep_type::difference_type     difference_type;
+
+		persistent_map() : t(Compare()) { }
+		explicit persistent_map(const Compare& cmp) : t(cmp) { }
+		persistent_map(const persistent_map& x) : t(x.t) { }
+		persistent_map(persistent_map&& x) : t(std::move(x.t)) { }
+		persistent_map& operator = (const persistent_map& x) { t = x.t; return *this; }
+		persistent_map& operator = (persistent_map&& x) { t = std::move(x.t); return *this; }
+
+		persistent_map snapshot() const { return *this; }    // O(1)，之后对*this的修改不影响快照
+
+		key_compare key_comp() const { return t.key_comp(); }
+		const_iterator begin() const { return t.begin(); }
+		const_iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		void swap(persistent_map& x) { t.swap(x.t); }
+
+		const_iterator find(const key_type& k) const { return t.find(k); }
+		const_iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+		size_type count(const key_type& k) const { return t.count(k); }
+		bool contains(const key_type& k) const { return t.count(k) != 0; }
+		const data_type* get(const key_type& k) const   // 没有时返回nullptr
+		{
+			const value_type* p = t.find_value(k);
+			return p == nullptr ? nullptr : &p->second;
+		}
+
+		bool insert(const value_type& x) { return t.insert_unique(x); }
+		bool insert_or_assign(const key_type& k, const data_type& data) { return t.insert_or_assign(value_type(k, data)); }
+		size_type erase(const key_type& k) { return t.erase(k); }
+		void clear() { t.clear(); }
+	};
+
+}  // namespace TinySTL
+
+#include "./Detail/Persistent_map.impl.h"
+
+#endif // !_PERSISTENT_MAP_H_
@@ -1,5 +1,5 @@
 #ifndef _RB_TREE_H_
-#define _RE_TREE_H_
+#define _RB_TREE_H_
 
 /*
 *   Author  @yyehl
@@ -10,6 +10,33 @@
 #include "Utility.h"
 #include "Construct.h"
 
+#include <new>
+#include <utility>
+
+/*
+*  rb_tree Ϊsetmapmultisetmultimapĵײ
+*
+*  headerһƼɣheader->parentΪڵ㣬header->leftΪСڵ㣬header->rightΪң󣩽ڵ㣬
+*  headerɫΪREDڵparentΪheaderend()ΪheaderʱڵΪnullptrheader->leftrightָheaderԼ
+*  ҶӽڵleftrightΪnullptr
+*
+*  OrderStatΪtrueʱÿڵⱣΪеĽڵsize롢ɾתʱ˳ά
+*  ɴrankkeyСԪظnthiԪأdistance֮ľ룩O(logN)
+*  ΪfalseʱȻãֻҪ˳ΪO(N)count_range(lo, hi)rank(hi) - rank(lo)ͬOrderStatΪtrueʱΪO(logN)
+*  ΪO(logN + K)KΪеԪظ
+*
+*  insert_unique(first, last)insert_equal(first, last)ʱΪգǰ׺룬
+*  ǰ˳ڵ㴮ֱӳһƽɫΪO(N)ڵ㰴η䣬ڴл
+*  һԪ֮Ĳֲ룬Զ벻Ҫı
+*
+*  insert_unique(hint, val)insert_equal(hint, val)ȼhintǰԪ֮ʱشӸڵң
+*  ֻʣĵΪ̯O(1)OrderStatΪtrueʱҪµsizeΪO(logN)˳׷ʱend()Ϊhint
+*
+*  set_unionset_intersectionset_differencesplitjoinsplit(T, k)Tkjoin(L, k, R)һ
+*  ڵӳһãֻĺڸ߲йأСΪmnm <= nʱϲΪO(mlog(n/m + 1))ڵֱӣڴ
+*
+*  extractѽڵժ·Žnode_typeinsertһʱֱڵ㣻mergexеÿڵͬ
+*/
 
 namespace TinySTL
 {
@@ -18,59 +45,40 @@ namespace TinySTL
 	const rb_tree_color BLACK = false;
 
 	/******************** class rb_tree_node **********************/
-	template<class Value>
+	template<class Value, bool OrderStat = false>
 	struct rb_tree_node
 	{
 		typedef rb_tree_color               tree_color;
-		typedef rb_tree_node<Value>*        node_ptr;
+		typedef rb_tree_node*               node_ptr;
 		typedef Value                       value_type;
 
-		Value value_field;
-		tree_color color;
+		node_ptr parent;
 		node_ptr left;
 		node_ptr right;
-		node_ptr parent;
-
-		rb_tree_node(const value_type& val = value_type(), tree_color color = RED, Tree_node* left = nullptr,
-			tree_node* right = nullptr, tree_node* parent = nullptr) 
-			: value_field(val), color(color), left(left), right(right), parent(parent) { }
-		explicit rb_tree_node(const value_type& val) { rb_tree_node(), value_field = val; }
-		rb_tree_node(const rb_tree_node<Value>& x) : value_field(x.value_field), color(x.color), left(nullptr), 
-			right(nullptr), parent(nullptr) { }
-	
-		static node_ptr min_value(node_ptr p)
-		{
-			while (p->left != nullptr)
-			{
-				p = p->left;
-			}
-			return p;
-		}
-		static node_ptr max_value(node_ptr p)
-		{
-			while (p->right != nullptr)
-			{
-				p = p->right;
-			}
-			return p;
-		}
-
+		tree_color color;
+		Value value_field;
 	};
+	// OrderStatΪtrueʱڵжⱣĽڵÿڵһsize_t
+	template<class Value>
+	struct rb_tree_node<Value, true>
+	{
+		typedef rb_tree_color               tree_color;
+		typedef rb_tree_node*               node_ptr;
+		typedef Value                       value_type;
 
-	/****************** class rb_tree_iterator **********************/
+		node_ptr parent;
+		node_ptr left;
+		node_ptr right;
+		tree_color color;
+		size_t size;          // ԸýڵΪеĽڵheadersizeΪ0
+		Value value_field;
+	};
 
-	template<class Value, class Ref, class Ptr>
-	bool operator == (const rb_tree_iterator<Value, Ref, Ptr>& lhs, const rb_tree_iterator<Value, Ref, Ptr>& rhs)
-	{
-		return lhs.node == rhs.node;
-	}
-	template<class Value, class Ref, class Ptr>
-	bool operator != (const rb_tree_iterator<Value, Ref, Ptr>& lhs, const rb_tree_iterator<Value, Ref, Ptr>& rhs)
-	{
-		return lhs.node != rhs.node;
-	}
+	template<bool OrderStat>
+	struct rb_tree_order_tag { };
 
-	template<class Value, class Ref, class Ptr>
+	/****************** class rb_tree_iterator **********************/
+	template<class Value, class Ref, class Ptr, bool OrderStat = false>
 	struct rb_tree_iterator
 	{
 		typedef bidirectional_iterator_tag    iterator_category;
@@ -79,68 +87,119 @@ namespace TinySTL
 		typedef Ptr                           pointer;
 		typedef size_t                        size_type;
 		typedef ptrdiff_t                     difference_type;
-		
-		typedef rb_tree_iterator<Value, Value&, Value*>                     iterator;
-		typedef rb_tree_iterator<const Value, const Value&, const Value*>   const_iterator;
-		typedef rb_tree_iterator<Value, Ref, Ptr>                           self;
-		typedef rb_tree_node<Value>                                         tree_node;
+
+		typedef rb_tree_iterator<Value, Value&, Value*, OrderStat>              iterator;
+		typedef rb_tree_iterator<Value, const Value&, const Value*, OrderStat>  const_iterator;
+		typedef rb_tree_iterator<Value, Ref, Ptr, OrderStat>                    self;
+		typedef rb_tree_node<Value, OrderStat>                                  tree_node;
 
 		tree_node* node;
 
-		rb_tree_iterator() { }
+		rb_tree_iterator() : node(nullptr) { }
 		rb_tree_iterator(tree_node* x) : node(x) { }
 		rb_tree_iterator(const iterator& x) : node(x.node) { }
 
-		reference operator * () { return node->value_field; }
-		pointer operator -> () { return &(*this); }
+		reference operator * () const { return node->value_field; }
+		pointer operator -> () const { return &(operator*()); }
 
 		self& operator ++ () { increase(); return *this; }
 		self operator ++ (int) { self tmp = *this; ++(*this); return tmp; }
 		self& operator -- () { decrease(); return *this; }
 		self operator -- (int) { self tmp = *this; --(*this); return tmp; }
 
-		bool operator == (const iterator& x) const { return node == x.node; }
-		bool operator != (const iterator& x) const { return !(*this == x); }
+		bool operator == (const self& x) const { return node == x.node; }
+		bool operator != (const self& x) const { return node != x.node; }
 
 		void increase();
 		void decrease();
-
 	};
 
-	/************************** class rb_tree ****************************/
+	/****************** class rb_tree_range **********************/
+	// [first, last)ͼֻʱǰԪ
+	template<class Iterator>
+	struct rb_tree_range
+	{
+		typedef Iterator    iterator;
+
+		Iterator first;
+		Iterator last;
+
+		rb_tree_range(Iterator f, Iterator l) : first(f), last(l) { }
+		Iterator begin() const { return first; }
+		Iterator end() const { return last; }
+		bool empty() const { return first == last; }
+	};
 
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+	/****************** class rb_tree_node_handle **********************/
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
 	class rb_tree;
 
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	bool operator == (const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& rhs)
+	// extractȡĽڵ㣬ֻƶܸƣڵ֮תʱ·䣬ҲvalueʱδеĽڵ
+	template<class Value, bool OrderStat, class Alloc>
+	class rb_tree_node_handle
 	{
-		return lhs.operator==(rhs);
-	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	bool operator != (const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& rhs)
-	{
-		return lhs.operator!=(rhs);
-	}
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void swap(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>&lhs, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& rhs)
-	{
-		return lhs.swap(rhs);
-	}
+		template<class K, class V, class KoV, class C, bool O, class A>
+		friend class rb_tree;
+
+	public:
+		typedef Value                             value_type;
+		typedef rb_tree_node<Value, OrderStat>    tree_node;
+
+		rb_tree_node_handle() : node(nullptr) { }
+		rb_tree_node_handle(rb_tree_node_handle&& x) : node(x.node) { x.node = nullptr; }
+		rb_tree_node_handle& operator = (rb_tree_node_handle&& x)
+		{
+			if (this != &x)
+			{
+				reset();
+				node = x.node;
+				x.node = nullptr;
+			}
+			return *this;
+		}
+		~rb_tree_node_handle() { reset(); }
 
+		bool empty() const { return node == nullptr; }
+		explicit operator bool () const { return node != nullptr; }
+		value_type& value() const { return node->value_field; }
+		void swap(rb_tree_node_handle& x) { tree_node* tmp = node; node = x.node; x.node = tmp; }
 
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = allocator<rb_tree_node<value>>>
+	private:
+		explicit rb_tree_node_handle(tree_node* p) : node(p) { }
+		rb_tree_node_handle(const rb_tree_node_handle&);
+		rb_tree_node_handle& operator = (const rb_tree_node_handle&);
+
+		tree_node* release() { tree_node* p = node; node = nullptr; return p; }
+		void reset()
+		{
+			if (node != nullptr)
+			{
+				destroy(&(node->value_field));
+				Alloc::deallocate(node);
+				node = nullptr;
+			}
+		}
+
+		tree_node* node;
+	};
+
+	/************************** class rb_tree ****************************/
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat = false,
+	         class Alloc = allocator<rb_tree_node<Value, OrderStat>>>
 	class rb_tree
 	{
-	public:
-		friend bool operator == (const rb_tree& lhs, const rb_tree& rhs);
-		friend bool operator != (const rb_tree& lhs, const rb_tree& rhs);
-		friend void swap(rb_tree& lhs, rb_tree& rhs);
+		/*
+		*  Keyֵ    Valueڵʵֵ    KeyOfValueʵֵȡֵķ    CompareֵıȽϷ
+		*  OrderStatڵǷ񱣴ĴС
+		*  AllocڵĿռ
+		*/
+
 	protected:
-		typedef void*                  void_pointer;
-		typedef rb_tree_node<Value>    tree_node;
-		typedef Alloc                  tree_node_allocator;
-		typedef rb_tree_color          color_type;
+		typedef rb_tree_node<Value, OrderStat>    tree_node;
+		typedef Alloc                             tree_node_allocator;
+		typedef rb_tree_color                     color_type;
+		typedef rb_tree_order_tag<OrderStat>      order_tag;
+		typedef rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>  self;
 
 	public:
 		typedef Key                    key_type;
@@ -151,89 +210,253 @@ namespace TinySTL
 		typedef const value_type&      const_reference;
 		typedef size_t                 size_type;
 		typedef ptrdiff_t              difference_type;
-		
-		typedef rb_tree_iterator<Value, Value&, Value*>                       iterator;
-		typedef rb_tree_iterator<const Value, const Value&, const Value*>     const_iterator;
+
+		typedef rb_tree_iterator<Value, Value&, Value*, OrderStat>              iterator;
+		typedef rb_tree_iterator<Value, const Value&, const Value*, OrderStat>  const_iterator;
+		typedef rb_tree_node_handle<Value, OrderStat, Alloc>                    node_type;
+		typedef rb_tree_range<iterator>                                         range_type;
+		typedef rb_tree_range<const_iterator>                                   const_range_type;
 
 	protected:    /* rb_tree_node Ĳ*/
 		tree_node* get_node() { return tree_node_allocator::allocate(); }  // һtree_nodeĿռ
 		void put_node(tree_node* p) { tree_node_allocator::deallocate(p); }  // һtree_nodeĿռ
-		tree_node* create_node(const value_type& val)     // һֵΪvaltree_nodeȷռ䣬ٹ
-			{ tree_node* p = get_node(); construct(p, val); return p; }  
+		template<class... Args>
+		tree_node* create_node(Args&&... args)     // һtree_nodeȷռ䣬args͵ع
+		{
+			tree_node* p = get_node();
+			new (&p->value_field) value_type(std::forward<Args>(args)...);
+			p->left = p->right = p->parent = nullptr;
+			set_size(p, 1, order_tag());
+			return p;
+		}
 		tree_node* clone_node(const tree_node* x)     // һtree_nodeڵ㣬ֻvalue_fieldcolor
-			{ tree_node* p = create_node(x->value_field); p->color = x->color; x->left = x->right = x->parent = nullptr; }
-		void destroy_node(tree_node* p) { destory(&(p->value_field)); put_node(p); } // һtree_node ٻտռ
-	
+		{
+			tree_node* p = create_node(x->value_field);
+			p->color = x->color;
+			return p;
+		}
+		void destroy_node(tree_node* p) { destroy(&(p->value_field)); put_node(p); } // һtree_node ٻտռ
+
 	protected:   // rb_treeݽṹ
 		size_type node_count; // ڵҲsize
-		tree_node* header;    // headerһƼɣparentΪڵ㣬leftΪֵrightΪֵcolorΪRED
+		tree_node* header;    // parentΪڵ㣬leftΪֵrightΪֵcolorΪRED
 		Compare key_compare;  // ڵkeyıȽ׼һ
-		tree_node* nil;   // ڱڵ
 
-	protected: 
-		tree_node*& root() const { return (tree_node*&)header->parent; }  
-		tree_node*& leftmost() const { return (tree_node*&)header->left; }
-		tree_node*& rightmost() const { return (tree_node*&)header->right; }
+	protected:
+		tree_node*& root() const { return header->parent; }
+		tree_node*& leftmost() const { return header->left; }
+		tree_node*& rightmost() const { return header->right; }
 
 		/* ºȡýڵxĳԱ */
-		static tree_node*& left(tree_node* p) { return (tree_node*&)p->left; }
-		static tree_node*& right(tree_node* p) { return (tree_node*&)p->right; }
-		static tree_node*& parent(tree_node* p) { return (tree_node*&)p->parent; }
+		static tree_node*& left(tree_node* p) { return p->left; }
+		static tree_node*& right(tree_node* p) { return p->right; }
+		static tree_node*& parent(tree_node* p) { return p->parent; }
 		static value_type& value(tree_node* p) { return p->value_field; }
 		static const key_type& key(tree_node* p) { return KeyOfValue()(value(p)); }
-		static color_type& color(tree_node* p) { return (color_type&)p->color; }
-
-		static tree_node* min_value_node(tree_node* p) { return rb_tree_node<Value>::min_value(p); }
-		static tree_node* max_value_node(tree_node* p) { return rb_tree_node<Value>::max_value(p); }
+		static color_type& color(tree_node* p) { return p->color; }
+
+		static tree_node* min_value_node(tree_node* p) { while (p->left != nullptr) p = p->left; return p; }
+		static tree_node* max_value_node(tree_node* p) { while (p->right != nullptr) p = p->right; return p; }
+
+		/* СOrderStatΪfalseʱЩʲôҲ */
+		static size_type subtree_size(tree_node* p) { return p == nullptr ? 0 : p->size; }
+		static void set_size(tree_node* p, size_type n, rb_tree_order_tag<true>) { p->size = n; }
+		static void set_size(tree_node*, size_type, rb_tree_order_tag<false>) { }
+		static void copy_size(tree_node* p, const tree_node* x, rb_tree_order_tag<true>) { p->size = x->size; }
+		static void copy_size(tree_node*, const tree_node*, rb_tree_order_tag<false>) { }
+		static void update_size(tree_node* p, rb_tree_order_tag<true>) { p->size = subtree_size(p->left) + subtree_size(p->right) + 1; }
+		static void update_size(tree_node*, rb_tree_order_tag<false>) { }
+		static void add_size_to_root(tree_node* p, tree_node* h, int delta, rb_tree_order_tag<true>)   // pڵ·ϵsizedelta
+		{
+			for (; p != h; p = p->parent)
+				p->size += delta;
+		}
+		static void add_size_to_root(tree_node*, tree_node*, int, rb_tree_order_tag<false>) { }
+		static void update_size_to_root(tree_node* p, tree_node* h, rb_tree_order_tag<true>)  // ¼pڵ·ϵsize
+		{
+			for (; p != h; p = p->parent)
+				update_size(p, rb_tree_order_tag<true>());
+		}
+		static void update_size_to_root(tree_node*, tree_node*, rb_tree_order_tag<false>) { }
 
-	private:  
-		void init() { header = get_node(); color(header) = RED; nil = get_node(); color(nil) = BLACK; root() = nil; leftmost() = rightmost() = header; }
-		iterator _insert(tree_node* x, tree_node* y, const value_type& val);
-		void _erase(tree_node* p);
-		tree_node* _copy(tree_node* x, tree_node* y);
+	private:
+		void init()
+		{
+			header = get_node();
+			color(header) = RED;
+			root() = nullptr;
+			leftmost() = rightmost() = header;
+			set_size(header, 0, order_tag());
+		}
+		iterator _insert(tree_node* x, tree_node* y, const value_type& val) { return _insert_node(x, y, create_node(val)); }
+		iterator _insert_node(tree_node* x, tree_node* y, tree_node* z);
+		/* ºزλ(x, y)_insertͬunique汾ֵͬʱ(нڵ, nullptr) */
+		pair<tree_node*, tree_node*> _get_insert_unique_pos(const key_type& k);
+		pair<tree_node*, tree_node*> _get_insert_equal_pos(const key_type& k);
+		pair<tree_node*, tree_node*> _get_insert_hint_unique_pos(iterator hint, const key_type& k);
+		pair<tree_node*, tree_node*> _get_insert_hint_equal_pos(iterator hint, const key_type& k);
+		pair<iterator, bool> _insert_unique_node(pair<tree_node*, tree_node*> pos, tree_node* z);
+		tree_node* _copy(tree_node* x, tree_node* p);
+		template<class InputIterator>
+		InputIterator _build_sorted(InputIterator first, InputIterator last, bool unique);
+		tree_node* _build(tree_node*& list, size_type n, size_type depth, size_type red_depth);
 
 	public:
-		rb_tree(const Compare& cmp = Compare()) : key_compare(cmp) { nil->color = BLACK; }
-		rb_tree(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& x);
-		~rb_tree() { clear(); put_node(header); put_node(nil); }
+		explicit rb_tree(const Compare& cmp = Compare()) : node_count(0), key_compare(cmp) { init(); }
+		rb_tree(const self& x);
+		~rb_tree() { clear(); put_node(header); }
 
-		rb_tree& operator = (const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& x);
+		self& operator = (const self& x);
 
 		Compare key_comp() const { return key_compare; }
-		iterator begin() { return iterator(header->left); }
+		iterator begin() { return iterator(leftmost()); }
 		iterator end() { return iterator(header); }
-		const_iterator begin() const { return const_iterator(header->left); }
+		const_iterator begin() const { return const_iterator(leftmost()); }
 		const_iterator end() const { return const_iterator(header); }
-		bool empty() const { return size() == 0; }
+		bool empty() const { return node_count == 0; }
 		size_type size() const { return node_count; }
 		size_type max_size() const { return size_type(-1); }
-		bool contain(const key_type& key) const;
+		bool contain(const key_type& key) const { return find(key) != end(); }
 
-		bool operator == (const rb_tree& x) { return header == x.header && key_compare = x.key_compare && node_count = x.node_count; }
-		bool operator != (const rb_tree& x) { return !(*this == x); }
+		bool operator == (const self& x) const;
+		bool operator != (const self& x) const { return !(*this == x); }
 
 		iterator insert_equal(const value_type& val);
 		pair<iterator, bool> insert_unique(const value_type& val);
-		void erase(tree_node* pos);
-		iterator find(const key_type& key); 
+		iterator insert_equal(iterator hint, const value_type& val);    // hintλʱΪ̯O(1)
+		iterator insert_unique(iterator hint, const value_type& val);
+		template<class InputIterator>
+		void insert_equal(InputIterator first, InputIterator last);
+		template<class InputIterator>
+		void insert_unique(InputIterator first, InputIterator last);
+		/* emplaceϵֱڽڵйvaluevalue_typeʱ */
+		template<class... Args>
+		iterator emplace_equal(Args&&... args)
+		{
+			tree_node* z = create_node(std::forward<Args>(args)...);
+			pair<tree_node*, tree_node*> pos = _get_insert_equal_pos(key(z));
+			return _insert_node(pos.first, pos.second, z);
+		}
+		template<class... Args>
+		pair<iterator, bool> emplace_unique(Args&&... args)
+		{
+			tree_node* z = create_node(std::forward<Args>(args)...);
+			return _insert_unique_node(_get_insert_unique_pos(key(z)), z);
+		}
+		template<class... Args>
+		iterator emplace_hint_equal(iterator hint, Args&&... args)
+		{
+			tree_node* z = create_node(std::forward<Args>(args)...);
+			pair<tree_node*, tree_node*> pos = _get_insert_hint_equal_pos(hint, key(z));
+			return _insert_node(pos.first, pos.second, z);
+		}
+		template<class... Args>
+		iterator emplace_hint_unique(iterator hint, Args&&... args)
+		{
+			tree_node* z = create_node(std::forward<Args>(args)...);
+			return _insert_unique_node(_get_insert_hint_unique_pos(hint, key(z)), z).first;
+		}
+		void erase(iterator pos);
+		size_type erase(const key_type& key);    // ɾмֵΪkeyԪأɾĸ
+
+		/* ڵȡתƣڵժºԭӵһϣڴ棬value */
+		node_type extract(iterator pos);
+		node_type extract(const key_type& key);      // ûмֵΪkeyԪʱؿյnode_type
+		pair<iterator, bool> insert_unique(node_type&& nh);   // ֵѴʱڵnhУеԪ
+		iterator insert_equal(node_type&& nh);
+		void merge_unique(self& x);    // x*thisûеļֵĽڵתƹx
+		void merge_equal(self& x);     // xнڵתƹ
+		iterator find(const key_type& key);
+		const_iterator find(const key_type& key) const { return const_cast<self*>(this)->find(key); }
+		size_type count(const key_type& key) const;
+
+		/* ѯ */
+		iterator lower_bound(const key_type& key);       // һֵСkeyԪ
+		iterator upper_bound(const key_type& key);       // һֵkeyԪ
+		const_iterator lower_bound(const key_type& key) const { return const_cast<self*>(this)->lower_bound(key); }
+		const_iterator upper_bound(const key_type& key) const { return const_cast<self*>(this)->upper_bound(key); }
+		pair<iterator, iterator> equal_range(const key_type& key) { return pair<iterator, iterator>(lower_bound(key), upper_bound(key)); }
+		pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			return pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+		}
+		range_type range(const key_type& lo, const key_type& hi)       // ֵ[lo, hi)еԪ
+		{
+			iterator first = lower_bound(lo);
+			return range_type(first, key_compare(lo, hi) ? lower_bound(hi) : first);
+		}
+		const_range_type range(const key_type& lo, const key_type& hi) const
+		{
+			range_type r = const_cast<self*>(this)->range(lo, hi);
+			return const_range_type(r.first, r.last);
+		}
+		size_type count_range(const key_type& lo, const key_type& hi) const { return count_range(lo, hi, order_tag()); }  // [lo, hi)еԪظ
 		void clear();
-		void swap(rb_tree& x);
+		void swap(self& x);
+
+		/* 㣬ֻڼֵΨһsetmap*thisУxĽڵ㱻٣xΪ
+		*  ֵͬʱ*thisеԪأmΪСһõĴСnΪϴһõĴСӶΪO(mlog(n/m + 1)) */
+		void set_union(self& x);
+		void set_intersection(self& x);
+		void set_difference(self& x);     // *thisɾxеļֵ
+
+		/* ˳ͳƣOrderStatΪtrueʱO(logN)O(N) */
+		size_type rank(const key_type& key) const { return rank(key, order_tag()); }          // ֵСkeyԪظ
+		iterator nth(size_type n) { return nth(n, order_tag()); }                             // nԪأ0ʼn >= size()ʱend()
+		const_iterator nth(size_type n) const { return const_cast<self*>(this)->nth(n); }
+		size_type index_of(const_iterator pos) const { return index_of(pos, order_tag()); }   // posǰԪظend()Ϊsize()
+		difference_type distance(const_iterator first, const_iterator last) const
+		{
+			return static_cast<difference_type>(index_of(last)) - static_cast<difference_type>(index_of(first));
+		}
 
 	private:
-		void destroy_tree(tree_node* root);
-		void rb_insert_balance(tree_node* x, tree_node*& root);
+		size_type destroy_tree(tree_node* root);    // ٵĽڵ
+		bool rb_insert_balance(tree_node* x, tree_node*& root);   // ظڵǷɺڣڸǷһ
 		void right_rotate(tree_node* x, tree_node*& root);
 		void left_rotate(tree_node* x, tree_node*& root);
-		void rb_erase_balance(bool l_or_r, tree_node* x, tree_node*& root);
-
-
+		tree_node* rb_erase_balance(tree_node* z);    // zժ²z
+		tree_node* _unlink(tree_node* z);             // ժzָcreate_nodeմʱ
+
+		/* splitjoinºĶǶڵparentΪnullptrɫΪڣhΪڸߣָ·ϵĺڽڵ */
+		static tree_node* _detach(tree_node* x, size_type& h);
+		tree_node* _join(tree_node* l, size_type hl, tree_node* k, tree_node* r, size_type hr, size_type& h);
+		tree_node* _join2(tree_node* l, size_type hl, tree_node* r, size_type hr, size_type& h);
+		tree_node* _split(tree_node* t, size_type h, const key_type& k, tree_node*& l, size_type& hl, tree_node*& r, size_type& hr);
+		tree_node* _union(tree_node* a, size_type ha, tree_node* b, size_type hb, size_type& h, size_type& removed);
+		tree_node* _intersection(tree_node* a, size_type ha, tree_node* b, size_type hb, size_type& h, size_type& removed);
+		tree_node* _difference(tree_node* a, size_type ha, tree_node* b, size_type hb, size_type& h, size_type& removed);
+		size_type black_height() const;
+		void take_root(tree_node* t, size_type n, self& x);
+
+		size_type rank(const key_type& key, rb_tree_order_tag<true>) const;
+		size_type rank(const key_type& key, rb_tree_order_tag<false>) const;
+		iterator nth(size_type n, rb_tree_order_tag<true>);
+		iterator nth(size_type n, rb_tree_order_tag<false>);
+		size_type index_of(const_iterator pos, rb_tree_order_tag<true>) const;
+		size_type index_of(const_iterator pos, rb_tree_order_tag<false>) const;
+		size_type count_range(const key_type& lo, const key_type& hi, rb_tree_order_tag<true>) const;
+		size_type count_range(const key_type& lo, const key_type& hi, rb_tree_order_tag<false>) const;
 	};  // end of class rb_tree
 
-
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	bool operator == (const rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>& lhs, const rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>& rhs)
+	{
+		return lhs.operator==(rhs);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	bool operator != (const rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>& lhs, const rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>& rhs)
+	{
+		return lhs.operator!=(rhs);
+	}
+	template<class Key, class Value, class KeyOfValue, class Compare, bool OrderStat, class Alloc>
+	void swap(rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>& lhs, rb_tree<Key, Value, KeyOfValue, Compare, OrderStat, Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
 
 } // namespace TinySTL
 
 #include "./Detail/RB_tree.impl.h"
 
 #endif // !_RB_TREE_H_
-
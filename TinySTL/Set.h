@@ -9,41 +9,47 @@
 #include "Functional.h"
 
 // ʣ setkeyvaluesetsetظsetͨ޸ֵ
+// OrderStatΪtrueʱranknthdistanceΪO(logN)ÿڵһsize_t
 
 namespace TinySTL
 {
-	template<class Key, class Compare = less<Key>>
+	template<class Key, class Compare = less<Key>, bool OrderStat = false>
 	class set
 	{
-	public: 
+	public:
 		typedef Key      key_type;           // setУkeyvalue
 		typedef Key      value_type;
 		typedef Compare  key_compare;
 		typedef Compare  value_compare;
 
 	private:
-		typedef rb_tree<Key, Key, identity<Key>, Compare>     rep_type;
-		
+		typedef rb_tree<Key, Key, identity<Key>, Compare, OrderStat>     rep_type;
+
 		rep_type t;   // setݽṹõrb_tree
 	public:
 		typedef typename rep_type::const_iterator     iterator;
 		typedef typename rep_type::const_iterator     const_iterator;
 		typedef typename rep_type::const_pointer      pointer;
 		typedef typename rep_type::const_pointer      const_pointer;
-		typedef typename rep_type::const_reference    cosnt_reference;
+		typedef typename rep_type::const_reference    const_reference;
 		typedef typename rep_type::const_reference    reference;
 
 		typedef typename rep_type::size_type          size_type;
 		typedef typename rep_type::difference_type    difference_type;
+		typedef typename rep_type::node_type          node_type;
+		typedef typename rep_type::const_range_type   range_type;
+		typedef typename rep_type::const_range_type   const_range_type;
 	private:
 		typedef typename rep_type::iterator           rep_iterator;
 
 	public:
 		set() : t(Compare()) { }
 		explicit set(const Compare& cmp) : t(cmp) { }
-		set(const set<Key, Compare>& x) : t(x.t) { }
+		set(const set& x) : t(x.t) { }
+		template<class InputIterator>
+		set(InputIterator first, InputIterator last) : t(Compare()) { t.insert_unique(first, last); }   // ΪO(N)
 
-		set<Key, Compare>& operator=(const set<Key, Compare>& x) { t = x.t; return *this; }
+		set& operator=(const set& x) { t = x.t; return *this; }
 
 		key_compare key_comp() const { return t.key_comp(); }
 		value_compare value_comp() const { return t.key_comp(); }
@@ -52,39 +58,73 @@ namespace TinySTL
 		bool empty() const { return t.empty(); }
 		size_type size() const { return t.size(); }
 		size_type max_size() const { return t.max_size(); }
-		void swap(set<Key, Compare>& x) { t.swap(x.t); }
+		void swap(set& x) { t.swap(x.t); }
 
-		pair<iterator, bool> insert(const value_type& val) 
+		// 㣬*thisУxգxĽڵֱӲ*this٣mΪСһĴСΪO(mlog(n/m + 1))
+		void set_union(set& x) { t.set_union(x.t); }
+		void set_intersection(set& x) { t.set_intersection(x.t); }
+		void set_difference(set& x) { t.set_difference(x.t); }
+
+		pair<iterator, bool> insert(const value_type& val)
 		{
-			pair<rep_iterator, bool> p = t.insert(val);
+			pair<rep_iterator, bool> p = t.insert_unique(val);
 			return pair<iterator, bool>(p.first, p.second);
 		}
-		void erase(iterator pos) { return t.erase(rep_iterator(pos.node)); }
-		void clear() { return t.clear(); }
+		iterator insert(iterator hint, const value_type& val) { return t.insert_unique(rep_iterator(hint.node), val); }   // hintλʱΪ̯O(1)
+		template<class... Args>
+		pair<iterator, bool> emplace(Args&&... args)
+		{
+			pair<rep_iterator, bool> p = t.emplace_unique(std::forward<Args>(args)...);
+			return pair<iterator, bool>(p.first, p.second);
+		}
+		template<class... Args>
+		iterator emplace_hint(iterator hint, Args&&... args) { return t.emplace_hint_unique(rep_iterator(hint.node), std::forward<Args>(args)...); }
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) { t.insert_unique(first, last); }
+		void erase(iterator pos) { t.erase(rep_iterator(pos.node)); }
+		size_type erase(const key_type& key) { return t.erase(key); }
+		node_type extract(iterator pos) { return t.extract(rep_iterator(pos.node)); }   // ȡڵ㣬
+		node_type extract(const key_type& key) { return t.extract(key); }
+		pair<iterator, bool> insert(node_type&& nh)    // ֱnhеĽڵ㣻ֵѴʱڵnh
+		{
+			pair<rep_iterator, bool> p = t.insert_unique(std::move(nh));
+			return pair<iterator, bool>(p.first, p.second);
+		}
+		void merge(set& x) { t.merge_unique(x.t); }   // xĽڵתƹ*thisеļֵx
+		void clear() { t.clear(); }
+
+		iterator find(const key_type& key) const { return t.find(key); }
+		size_type count(const key_type& key) const { return t.count(key); }
 
-		iterator find(const value_type& val) const { return t.find(val); }
+		// ѯrange(lo, hi)Ϊ[lo, hi)ͼʱǰcount_rangeOrderStatΪtrueʱΪO(logN)
+		iterator lower_bound(const key_type& key) const { return t.lower_bound(key); }
+		iterator upper_bound(const key_type& key) const { return t.upper_bound(key); }
+		pair<iterator, iterator> equal_range(const key_type& key) const { return t.equal_range(key); }
+		range_type range(const key_type& lo, const key_type& hi) const { return t.range(lo, hi); }
+		size_type count_range(const key_type& lo, const key_type& hi) const { return t.count_range(lo, hi); }
 
-		bool operator == (const set<Key, Compare>& y) const
+		// ˳ͳƣrankΪСkeyԪظnthΪnԪأ0ʼdistanceΪ֮Ԫظ
+		size_type rank(const key_type& key) const { return t.rank(key); }
+		iterator nth(size_type n) const { return t.nth(n); }
+		difference_type distance(iterator first, iterator last) const { return t.distance(first, last); }
+
+		bool operator == (const set& y) const
 		{
 			return t == y.t;
 		}
-		bool operator != (const set<Key, Compare>& y) const
+		bool operator != (const set& y) const
 		{
 			return !(t == y.t);
 		}
-
-		friend bool operator == <> (const set<Key, Compare>& x, const set<Key, Compare>& y);
-		friend bool operator != <> (const set<Key, Compare>& x, const set<Key, Compare>& y);
-
 	};  // end of class set;
 
-	template<class Key, class Compare>
-	bool operator == (const set<Key, Compare>& x, const set<Key, Compare>& y)
+	template<class Key, class Compare, bool OrderStat>
+	bool operator == (const set<Key, Compare, OrderStat>& x, const set<Key, Compare, OrderStat>& y)
 	{
 		return x.operator==(y);
 	}
-	template<class Key, class Compare>
-	bool operator != (const set<Key, Compare>& x, const set<Key, Compare>& y)
+	template<class Key, class Compare, bool OrderStat>
+	bool operator != (const set<Key, Compare, OrderStat>& x, const set<Key, Compare, OrderStat>& y)
 	{
 		return x.operator!=(y);
 	}
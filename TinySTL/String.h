@@ -11,6 +11,7 @@
 #include "Iterator.h"
 #include <cstring>
 #include "Algorithm.h"
+#include "./Detail/hash_functions.h"
 #include <iostream>
 
 
@@ -151,7 +152,12 @@ namespace TinySTL
 
 };
 
-
+	// 按字符串的内容求hash，与相同内容的string_view、const char*得到的hash值相同
+	template<>
+	struct hash<string>
+	{
+		size_t operator()(const string& str) const { return hash_fcn_string(str.begin(), str.size()); }
+	};
 
 
 }  // namespace TinySTL
@@ -0,0 +1,132 @@
+#ifndef _STRING_POOL_H_
+#define _STRING_POOL_H_
+
+/*
+*	Author  @yyehl
+*/
+
+#include "Allocator.h"
+#include "Vector.h"
+#include "Utility.h"
+#include "String.h"
+#include "String_view.h"
+#include "./Detail/hash_functions.h"
+
+/*
+*  string_pool：字符串驻留池
+*  相同内容的字符串在池中只保存一份，存放在池自己管理的大块内存（arena）里
+*  intern() 返回一个 string_handle，只有8个字节：一个编号和一个预先算好的hash值
+*  handle之间比较相等只需比较编号，O(1)；求hash直接返回保存的值，不需要再扫描字符串
+*  所以handle可以直接作为hashtable（hash<string_handle>）和rb_tree（less<string_handle>）的key
+*
+*  注意：
+*  1. handle的大小顺序是驻留的先后顺序，不是字典序，需要字典序时请用 view() 取出内容比较
+*  2. 不同pool产生的handle之间不能比较
+*  3. pool析构或clear()之后，之前得到的handle和view()都失效
+*/
+
+namespace TinySTL
+{
+	/*********************** class string_handle *****************************/
+	class string_handle
+	{
+	public:
+		typedef unsigned int id_type;
+
+	private:
+		friend class string_pool;
+
+		id_type _id;          // 在pool中的编号，从1开始，0表示空handle
+		unsigned int _hash;   // 驻留时计算好的hash值
+
+		string_handle(id_type id, unsigned int h) : _id(id), _hash(h) { }
+
+	public:
+		string_handle() : _id(0), _hash(0) { }
+
+		id_type id() const { return _id; }
+		size_t hash() const { return _hash; }
+		bool null() const { return _id == 0; }
+
+		bool operator == (const string_handle& x) const { return _id == x._id; }
+		bool operator != (const string_handle& x) const { return _id != x._id; }
+		bool operator < (const string_handle& x) const { return _id < x._id; }
+		bool operator > (const string_handle& x) const { return _id > x._id; }
+		bool operator <= (const string_handle& x) const { return _id <= x._id; }
+		bool operator >= (const string_handle& x) const { return _id >= x._id; }
+	};
+
+	// 直接使用保存的hash值，不需要重新计算
+	template<>
+	struct hash<string_handle>
+	{
+		size_t operator()(const string_handle& h) const { return h.hash(); }
+	};
+
+	/*********************** class string_pool *****************************/
+	class string_pool
+	{
+	public:
+		typedef size_t    size_type;
+
+	private:
+		typedef allocator<char>   data_allocator;
+
+		struct entry
+		{
+			const char* data;     // 指向arena中的字符，末尾额外保存一个'\0'
+			size_type len;
+			unsigned int hash;
+		};
+
+		// 以下是string_pool的数据结构
+		vector<entry> entries;              // 编号为id的字符串保存在entries[id - 1]
+		vector<string_handle::id_type> slots;   // 开放定址的索引表，大小为2的幂，0表示空槽
+		vector<pair<char*, size_type> > blocks; // arena中所有的内存块及其大小
+		char* cur;                          // 当前内存块中未使用部分的起始位置
+		char* last;                         // 当前内存块的末尾
+		size_type block_size;               // 每次向配置器申请的内存块大小
+		size_type bytes;                    // 所有驻留字符串的总字节数（不含'\0'）
+
+	public:
+		explicit string_pool(size_type block = 4096)
+			: cur(nullptr), last(nullptr), block_size(block), bytes(0) { }
+		~string_pool() { release(); }
+
+		string_handle intern(const char* s, size_type n);
+		string_handle intern(const char* s) { return intern(s, strlen(s)); }
+		string_handle intern(const string& str) { return intern(str.begin(), str.size()); }
+		string_handle intern(const string_view& sv) { return intern(sv.data(), sv.size()); }
+
+		// 只查找不插入，没有驻留过则返回空handle
+		string_handle find(const char* s, size_type n) const;
+		string_handle find(const string_view& sv) const { return find(sv.data(), sv.size()); }
+
+		// 空handle（比如find没有找到）对应空字符串
+		string_view view(const string_handle& h) const
+		{
+			if (h.null())
+				return string_view("");
+			const entry& e = entries[h.id() - 1];
+			return string_view(e.data, e.len);
+		}
+		const char* c_str(const string_handle& h) const { return h.null() ? "" : entries[h.id() - 1].data; }
+
+		size_type size() const { return entries.size(); }
+		bool empty() const { return entries.size() == 0; }
+		size_type bytes_used() const { return bytes; }
+		void clear() { release(); }
+
+	private:
+		string_pool(const string_pool&);              // handle依赖于pool的地址，不允许复制
+		string_pool& operator = (const string_pool&);
+
+		char* store(const char* s, size_type n);      // 把字符串复制进arena
+		void grow_slots();                            // 索引表扩容并重新放置所有编号
+		void release();                               // 回收全部内存
+	};
+
+}  // namespace TinySTL
+
+
+#endif // !_STRING_POOL_H_
@@ -0,0 +1,129 @@
+#ifndef _STRING_VIEW_H_
+#define _STRING_VIEW_H_
+
+/*
+*	Author  @yyehl
+*/
+
+#include "String.h"
+#include "./Detail/hash_functions.h"
+#include <cstring>
+#include <iostream>
+
+/*
+*  string_view 只保存一个指针和一个长度，不拥有字符的内存，也不要求以'\0'结尾
+*  使用者需要保证 string_view 存活期间，其指向的内存始终有效
+*/
+
+namespace TinySTL
+{
+	class string_view
+	{
+	public:
+		typedef char          value_type;
+		typedef const char*   iterator;
+		typedef const char*   const_iterator;
+		typedef const char&   reference;
+		typedef const char&   const_reference;
+		typedef size_t        size_type;
+		typedef ptrdiff_t     difference_type;
+
+		static const size_type npos = -1;
+
+	private:
+		const char* _data;
+		size_type _size;
+
+	public:
+		string_view() : _data(nullptr), _size(0) { }
+		string_view(const char* s) : _data(s), _size(strlen(s)) { }
+		string_view(const char* s, size_type n) : _data(s), _size(n) { }
+		string_view(const char* first, const char* last) : _data(first), _size(last - first) { }
+		string_view(const string& str) : _data(str.begin()), _size(str.size()) { }
+
+		const_iterator begin() const { return _data; }
+		const_iterator end() const { return _data + _size; }
+		const_iterator cbegin() const { return _data; }
+		const_iterator cend() const { return _data + _size; }
+
+		const char& operator[] (size_type n) const { return *(_data + n); }
+		const char& front() const { return *_data; }
+		const char& back() const { return *(_data + _size - 1); }
+		const char* data() const { return _data; }
+
+		size_type size() const { return _size; }
+		size_type length() const { return _size; }
+		bool empty() const { return _size == 0; }
+
+		void remove_prefix(size_type n) { _data += n; _size -= n; }
+		void remove_suffix(size_type n) { _size -= n; }
+
+		// 截取[pos, pos + n)，n超出末尾时截到末尾为止
+		string_view substr(size_type pos, size_type n = npos) const
+		{
+			if (n > _size - pos)
+				n = _size - pos;
+			return string_view(_data + pos, n);
+		}
+
+		// 从pos开始查找字符c，找不到返回npos
+		size_type find(char c, size_type pos = 0) const
+		{
+			if (pos >= _size)
+				return npos;
+			const void* p = memchr(_data + pos, c, _size - pos);
+			return p == nullptr ? npos : static_cast<const char*>(p) - _data;
+		}
+
+		// 小于返回负数，相等返回0，大于返回正数
+		int compare(const string_view& x) const
+		{
+			size_type len = _size < x._size ? _size : x._size;
+			int ret = (len == 0) ? 0 : memcmp(_data, x._data, len);
+			if (ret != 0)
+				return ret;
+			return (_size < x._size) ? -1 : (_size == x._size ? 0 : 1);
+		}
+
+		string to_string() const { return string(begin(), end()); }
+	};
+
+	inline bool operator== (const string_view& lhs, const string_view& rhs)
+	{
+		return lhs.size() == rhs.size() && (lhs.size() == 0 || memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+	}
+	inline bool operator!= (const string_view& lhs, const string_view& rhs) { return !(lhs == rhs); }
+	inline bool operator< (const string_view& lhs, const string_view& rhs) { return lhs.compare(rhs) < 0; }
+	inline bool operator<= (const string_view& lhs, const string_view& rhs) { return lhs.compare(rhs) <= 0; }
+	inline bool operator> (const string_view& lhs, const string_view& rhs) { return lhs.compare(rhs) > 0; }
+	inline bool operator>= (const string_view& lhs, const string_view& rhs) { return lhs.compare(rhs) >= 0; }
+
+	inline std::ostream& operator << (std::ostream& os, const string_view& sv)
+	{
+		os.write(sv.data(), sv.size());
+		return os;
+	}
+
+	template<>
+	struct hash<string_view>
+	{
+		size_t operator()(const string_view& sv) const { return hash_fcn_string(sv.data(), sv.size()); }
+	};
+
+	// 透明的hash与相等比较，string、string_view、const char*得到相同的hash值，可以互相比较
+	// 作为hash_map<string, T, string_hash, string_equal>的模板参数时，find可以直接传const char*或string_view
+	struct string_hash
+	{
+		typedef void is_transparent;
+		size_t operator()(const string_view& sv) const { return hash_fcn_string(sv.data(), sv.size()); }
+	};
+	struct string_equal
+	{
+		typedef void is_transparent;
+		bool operator()(const string_view& lhs, const string_view& rhs) const { return lhs == rhs; }
+	};
+
+}  // namespace TinySTL
+
+
+#endif // !_STRING_VIEW_H_
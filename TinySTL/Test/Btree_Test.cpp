@@ -0,0 +1,185 @@
+#include "Btree_Test.h"
+
+namespace TinySTL {
+	namespace BtreeTest {
+
+		// NodeBytes为1时每个节点只放3个元素（capacity的下限），元素不多就会分裂、借元素、合并，树也更高
+		typedef btree_map<int, int, less<int>, 1>       small_map;
+		typedef btree_multimap<int, int, less<int>, 1>  small_multimap;
+
+		// 正向、反向遍历都与ref一致
+		template<class Tree, class Ref>
+		void check_equal(const Tree& t, const Ref& ref) {
+			assert(t.size() == ref.size() && t.empty() == ref.empty());
+			auto it = t.begin();
+			for (auto r = ref.begin(); r != ref.end(); ++r, ++it) {
+				assert(it != t.end());
+				assert(it->first == r->first && it->second == r->second);
+			}
+			assert(it == t.end());
+			for (auto r = ref.rbegin(); r != ref.rend(); ++r) {
+				--it;
+				assert(it->first == r->first && it->second == r->second);
+			}
+			assert(it == t.begin());
+		}
+
+		void testCase1() {
+			// btree_map与std::map对照：insert、operator[]、erase(key)、erase(iterator)的返回值、find、lower_bound
+			std::mt19937 rng(1);
+			small_map m;
+			std::map<int, int> ref;
+			for (int i = 0; i < 40000; ++i) {
+				int key = rng() % 2000;
+				switch (rng() % 5) {
+				case 0:
+					assert(m.insert(pair<const int, int>(key, i)).second == ref.insert(std::make_pair(key, i)).second);
+					break;
+				case 1:
+					m[key] = i;
+					ref[key] = i;
+					break;
+				case 2:
+					assert(m.erase(key) == ref.erase(key));
+					break;
+				case 3: {
+					auto it = m.lower_bound(key);
+					auto r = ref.lower_bound(key);
+					assert((it == m.end()) == (r == ref.end()));
+					if (r != ref.end()) {
+						assert(it->first == r->first);
+						it = m.erase(it);        // 返回被删除元素的下一个，可能在别的节点中
+						r = ref.erase(r);
+						assert((it == m.end()) == (r == ref.end()));
+						assert(r == ref.end() || (it->first == r->first && it->second == r->second));
+					}
+					break;
+				}
+				default: {
+					auto it = m.find(key);
+					auto r = ref.find(key);
+					assert((it == m.end()) == (r == ref.end()));
+					assert(r == ref.end() || it->second == r->second);
+				}
+				}
+				if (i % 2000 == 0)
+					check_equal(m, ref);
+			}
+			check_equal(m, ref);
+
+			// 从前往后逐个erase(iterator)删光，每次删的都是最左边的元素
+			for (auto it = m.begin(); it != m.end(); ) {
+				auto r = ref.begin();
+				assert(it->first == r->first);
+				it = m.erase(it);
+				ref.erase(r);
+				assert(it == m.begin());
+			}
+			assert(m.empty() && ref.empty());
+		}
+		void testCase2() {
+			// btree_multimap与std::multimap对照：重复的key、count、equal_range、erase(key)
+			std::mt19937 rng(2);
+			small_multimap m;
+			std::multimap<int, int> ref;
+			for (int i = 0; i < 30000; ++i) {
+				int key = rng() % 300;
+				switch (rng() % 4) {
+				case 0:
+				case 1:
+					m.insert(pair<const int, int>(key, key * 3));     // value由key决定，重复key之间的顺序不影响比较
+					ref.insert(std::make_pair(key, key * 3));
+					break;
+				case 2:
+					assert(m.erase(key) == ref.erase(key));
+					break;
+				default: {
+					assert(m.count(key) == ref.count(key));
+					auto r = m.equal_range(key);
+					size_t n = 0;
+					for (auto it = r.first; it != r.second; ++it, ++n)
+						assert(it->first == key);
+					assert(n == ref.count(key));
+				}
+				}
+				if (i % 2000 == 0)
+					check_equal(m, ref);
+			}
+			check_equal(m, ref);
+		}
+		void testCase3() {
+			// 区间删除、复制构造、赋值、比较
+			std::mt19937 rng(3);
+			small_map m;
+			std::map<int, int> ref;
+			for (int i = 0; i < 3000; ++i) {
+				int key = rng() % 10000;
+				m[key] = i;
+				ref[key] = i;
+			}
+
+			const size_t n = ref.size();
+			small_map copy(m);
+			check_equal(copy, ref);
+			assert(copy == m);
+			small_map assigned;
+			assigned[1] = 1;
+			assigned = m;
+			check_equal(assigned, ref);
+			assigned = assigned;
+			check_equal(assigned, ref);
+
+			for (int k = 0; k < 50 && !ref.empty(); ++k) {
+				int lo = rng() % 10000, hi = lo + rng() % 500;
+				auto it = m.erase(m.lower_bound(lo), m.lower_bound(hi));
+				auto r = ref.erase(ref.lower_bound(lo), ref.lower_bound(hi));
+				assert((it == m.end()) == (r == ref.end()));
+				assert(r == ref.end() || it->first == r->first);
+			}
+			check_equal(m, ref);
+			auto last = m.erase(m.begin(), m.end());
+			assert(last == m.end() && m.empty());
+			assert(copy != m && copy.size() == n && copy == assigned);     // 修改m不影响它的副本
+
+			m.swap(copy);
+			assert(copy.empty() && m == assigned);
+			m.clear();
+			assert(m.empty() && m.begin() == m.end());
+			m[5] = 5;
+			assert(m.size() == 1 && m.begin()->second == 5);
+		}
+		void testCase4() {
+			// key为std::string：节点内移动元素、分裂、合并时key和value都是移动而不是复制
+			std::mt19937 rng(4);
+			btree_map<std::string, std::string, less<std::string>, 1> m;
+			std::map<std::string, std::string> ref;
+			for (int i = 0; i < 5000; ++i) {
+				std::string key = "key-" + std::to_string(rng() % 1000) + std::string(20, 'k');
+				if (rng() % 3 != 0) {
+					m[key] = key + "-value";
+					ref[key] = key + "-value";
+				}
+				else
+					assert(m.erase(key) == ref.erase(key));
+			}
+			check_equal(m, ref);
+
+			btree_set<int> s;             // 默认的NodeBytes
+			for (int i = 0; i < 20000; ++i)
+				s.insert((i * 7919) % 20011);
+			int prev = -1;
+			for (auto it = s.begin(); it != s.end(); ++it) {
+				assert(*it > prev);
+				prev = *it;
+			}
+			assert(s.size() == 20000);
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+			testCase4();
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#ifndef _BTREE_TEST_H_
+#define _BTREE_TEST_H_
+
+#include "../Btree_map.h"
+#include "../Btree_set.h"
+#include "test_fun.h"
+
+#include <cassert>
+#include <map>
+#include <random>
+#include <string>
+
+namespace TinySTL {
+	namespace BtreeTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testCase4();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_BTREE_TEST_H_
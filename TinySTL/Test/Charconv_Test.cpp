@@ -0,0 +1,165 @@
+#include "Charconv_Test.h"
+
+namespace TinySTL {
+	namespace CharconvTest {
+
+		void testCase1() {
+			char buf[32];
+			long long arr[] = { 0, 7, -7, 10, 99, 100, -12345, 2147483647, LLONG_MAX, LLONG_MIN };
+			for (auto v : arr) {
+				auto r = TinySTL::to_chars(buf, buf + sizeof(buf), v);
+				assert(r.ec == std::errc());
+				char expect[32];
+				int n = std::snprintf(expect, sizeof(expect), "%lld", v);
+				assert(r.ptr - buf == n);
+				assert(std::memcmp(buf, expect, n) == 0);
+			}
+
+			auto r = TinySTL::to_chars(buf, buf + 3, 1234);
+			assert(r.ec == std::errc::value_too_large);
+		}
+		void testCase2() {
+			const char* s = "-2147483648";
+			int x = 0;
+			auto r = TinySTL::from_chars(s, s + std::strlen(s), x);
+			assert(r.ec == std::errc() && x == INT_MIN && r.ptr == s + std::strlen(s));
+
+			s = "2147483648";
+			r = TinySTL::from_chars(s, s + std::strlen(s), x);
+			assert(r.ec == std::errc::result_out_of_range && x == INT_MIN);
+
+			s = "42abc";
+			r = TinySTL::from_chars(s, s + std::strlen(s), x);
+			assert(r.ec == std::errc() && x == 42 && r.ptr == s + 2);
+
+			unsigned u = 0;
+			s = "-1";
+			r = TinySTL::from_chars(s, s + std::strlen(s), u);
+			assert(r.ec == std::errc::invalid_argument && r.ptr == s);
+		}
+		void testCase3() {
+			struct { double val; const char* str; } arr[] = {
+				{ 0.0, "0" }, { -0.0, "-0" }, { 1.0, "1" }, { 0.1, "0.1" }, { 0.3, "0.3" },
+				{ 123.456, "123.456" }, { 1e21, "1e+21" }, { 1e-7, "1e-07" }, { 5e-324, "5e-324" },
+				{ 1.7976931348623157e308, "1.7976931348623157e+308" }, { 100.0, "100" }
+			};
+			char buf[32];
+			for (auto& t : arr) {
+				auto r = TinySTL::to_chars(buf, buf + sizeof(buf), t.val);
+				assert(r.ec == std::errc());
+				assert(std::string(buf, r.ptr) == t.str);
+			}
+			auto r = TinySTL::to_chars(buf, buf + sizeof(buf), 0.1f);
+			assert(std::string(buf, r.ptr) == "0.1");
+		}
+		void testCase4() {
+			std::mt19937_64 rng(2016);
+			char buf[32];
+			for (int i = 0; i != 100000; ++i) {
+				unsigned long long bits = rng();
+				double v;
+				std::memcpy(&v, &bits, sizeof(v));
+				if (!std::isfinite(v))
+					continue;
+				auto r = TinySTL::to_chars(buf, buf + sizeof(buf), v);
+				double back = 0;
+				auto p = TinySTL::from_chars(buf, r.ptr, back);
+				assert(p.ec == std::errc() && p.ptr == r.ptr && back == v);
+			}
+		}
+		void testCase5() {
+			const char* arr[] = { "1.5e3", "0.000123", "-2.5", "123456789012345678901234567890", "4.9e-324", "3.14159" };
+			for (auto s : arr) {
+				double v = 0;
+				auto r = TinySTL::from_chars(s, s + std::strlen(s), v);
+				assert(r.ec == std::errc() && v == std::strtod(s, nullptr));
+			}
+			double v = 0;
+			const char* s = "1e999";
+			auto r = TinySTL::from_chars(s, s + std::strlen(s), v);
+			assert(r.ec == std::errc::result_out_of_range);
+
+			assert(TinySTL::to_string(-42) == "-42");
+			assert(TinySTL::to_string(0.5) == "0.5");
+		}
+		void testCase6() {
+			// 快速路径之外：17位有效数字、大指数、中点、超过19位有效数字
+			struct { const char* str; double val; } arr[] = {
+				{ "0.30000000000000004", 0.30000000000000004 }, { "6.02214076e23", 6.02214076e23 },
+				{ "2.2250738585072011e-308", 2.2250738585072011e-308 }, { "2.4703282292062328e-324", 5e-324 },
+				{ "9007199254740993", 9007199254740992.0 }, { "9007199254740993.00000000000000000000001", 9007199254740994.0 },
+				{ "1.7976931348623157e308", 1.7976931348623157e308 }, { "-1e-300", -1e-300 }
+			};
+			for (auto& t : arr) {
+				double v = 0;
+				auto r = TinySTL::from_chars(t.str, t.str + std::strlen(t.str), v);
+				assert(r.ec == std::errc() && r.ptr == t.str + std::strlen(t.str) && v == t.val);
+			}
+			float f = 0;
+			const char* s = "1.00000005960464477550";
+			TinySTL::from_chars(s, s + std::strlen(s), f);
+			assert(f == 1.00000005960464477550f);
+			s = "2.4703282292062327e-324";
+			double v = 1;
+			assert(TinySTL::from_chars(s, s + std::strlen(s), v).ec == std::errc::result_out_of_range && v == 1);
+		}
+		// 有效数字的个数：不算前导的0和定点表示中末尾的0
+		static int significant_digits(const char* first, const char* last) {
+			std::string m(first, std::find(first, last, 'e'));
+			m.erase(std::remove(m.begin(), m.end(), '.'), m.end());
+			m.erase(std::remove(m.begin(), m.end(), '-'), m.end());
+			size_t b = m.find_first_not_of('0'), e = m.find_last_not_of('0');
+			return b == std::string::npos ? 0 : static_cast<int>(e - b + 1);
+		}
+		void testCase7() {
+			// 前三个是Grisu2输出得不是最短的例子
+			struct { double val; const char* str; } arr[] = {
+				{ 4.1752050594835004e+78, "4.1752050594835e+78" }, { 3.4840604866914067e+210, "3.484060486691407e+210" },
+				{ 1e23, "1e+23" }, { 2.2250738585072009e-308, "2.225073858507201e-308" },
+				{ 9007199254740993.0, "9007199254740992" }, { 5e-310, "5e-310" }
+			};
+			char buf[32];
+			for (auto& t : arr) {
+				auto r = TinySTL::to_chars(buf, buf + sizeof(buf), t.val);
+				assert(std::string(buf, r.ptr) == t.str);
+			}
+			// 与printf比较：少一位有效数字时，最近的那个数读回来一定不是v
+			std::mt19937_64 rng(2027);
+			char tmp[40];
+			for (int i = 0; i != 100000; ++i) {
+				unsigned long long bits = rng();
+				double v;
+				std::memcpy(&v, &bits, sizeof(v));
+				if (!std::isfinite(v))
+					continue;
+				auto r = TinySTL::to_chars(buf, buf + sizeof(buf), v);
+				int n = significant_digits(buf, r.ptr);
+				if (n > 1) {
+					std::snprintf(tmp, sizeof(tmp), "%.*e", n - 2, v);
+					assert(std::strtod(tmp, nullptr) != v);
+				}
+				float f;
+				unsigned fbits = static_cast<unsigned>(bits);
+				std::memcpy(&f, &fbits, sizeof(f));
+				if (!std::isfinite(f))
+					continue;
+				r = TinySTL::to_chars(buf, buf + sizeof(buf), f);
+				n = significant_digits(buf, r.ptr);
+				if (n > 1) {
+					std::snprintf(tmp, sizeof(tmp), "%.*e", n - 2, f);
+					assert(std::strtof(tmp, nullptr) != f);
+				}
+			}
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+			testCase4();
+			testCase5();
+			testCase6();
+			testCase7();
+		}
+	}
+}
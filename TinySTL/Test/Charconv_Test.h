@@ -0,0 +1,32 @@
+#ifndef _CHARCONV_TEST_H_
+#define _CHARCONV_TEST_H_
+
+#include "../Charconv.h"
+#include "test_fun.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace TinySTL {
+	namespace CharconvTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testCase4();
+		void testCase5();
+		void testCase6();
+		void testCase7();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_CHARCONV_TEST_H_
@@ -0,0 +1,98 @@
+#include "Concurrent_hash_map_Test.h"
+
+namespace TinySTL {
+	namespace Concurrent_hash_mapTest {
+
+		string make_key(int n) {
+			char buf[32];
+			int len = std::snprintf(buf, sizeof(buf), "key-%d", n);
+			return string(buf, static_cast<size_t>(len));
+		}
+
+		void testCase1() {
+			// 单线程语义，与std::unordered_map对照
+			std::mt19937 rng(1);
+			concurrent_hash_map<int, int> m(16, 4);
+			std::unordered_map<int, int> ref;
+			for (int i = 0; i < 100000; ++i) {
+				int key = rng() % 5000;
+				switch (rng() % 4) {
+				case 0:
+					assert(m.insert_unique(pair<const int, int>(key, i)) == ref.insert(std::make_pair(key, i)).second);
+					break;
+				case 1:
+					assert(m.insert_or_update(key, i) == (ref.count(key) == 0));
+					ref[key] = i;
+					break;
+				case 2:
+					assert(m.erase(key) == ref.erase(key));
+					break;
+				default: {
+					int out = -1;
+					auto it = ref.find(key);
+					assert(m.find(key, out) == (it != ref.end()));
+					assert(it == ref.end() || out == it->second);
+				}
+				}
+			}
+			assert(m.size() == ref.size());
+			m.clear();
+			assert(m.empty());
+		}
+		void testCase2() {
+			// 8个线程同时读写，key和value都是TinySTL::string（经过alloc分配内存）；
+			// 每个线程只修改属于自己的key（n % T == t），最后与各自的记录对照
+			const int T = 8, OPS = 50000, K = 8000;
+			concurrent_hash_map<string, string> m;
+			std::vector<std::vector<int>> owned(T, std::vector<int>(K / T, -1));    // owned[t][i]：key i * T + t当前的值，-1为不存在
+			std::vector<std::thread> threads;
+			for (int t = 0; t < T; ++t) {
+				threads.emplace_back([&, t] {
+					std::mt19937 rng(t + 1);
+					std::vector<int>& ref = owned[t];
+					for (int i = 0; i < OPS; ++i) {
+						int slot = rng() % (K / T);
+						string key = make_key(slot * T + t);
+						switch (rng() % 3) {
+						case 0:
+							assert(m.insert_or_update(key, make_key(i)) == (ref[slot] < 0));
+							ref[slot] = i;
+							break;
+						case 1:
+							assert(m.erase(key) == (ref[slot] < 0 ? 0u : 1u));
+							ref[slot] = -1;
+							break;
+						default: {
+							string out;
+							assert(m.find(key, out) == (ref[slot] >= 0));
+							assert(ref[slot] < 0 || out == make_key(ref[slot]));
+							m.contains(make_key(rng() % K));     // 别的线程正在修改的key
+						}
+						}
+					}
+				});
+			}
+			for (auto& th : threads)
+				th.join();
+
+			size_t n = 0;
+			for (int t = 0; t < T; ++t) {
+				for (int slot = 0; slot < K / T; ++slot) {
+					string out;
+					int v = owned[t][slot];
+					assert(m.find(make_key(slot * T + t), out) == (v >= 0));
+					if (v >= 0) {
+						assert(out == make_key(v));
+						++n;
+					}
+				}
+			}
+			assert(m.size() == n);
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+		}
+	}
+}
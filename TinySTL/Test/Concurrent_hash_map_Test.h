@@ -0,0 +1,25 @@
+#ifndef _CONCURRENT_HASH_MAP_TEST_H_
+#define _CONCURRENT_HASH_MAP_TEST_H_
+
+#include "../Concurrent_hash_map.h"
+#include "../String.h"
+#include "test_fun.h"
+
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace TinySTL {
+	namespace Concurrent_hash_mapTest {
+
+		void testCase1();
+		void testCase2();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_CONCURRENT_HASH_MAP_TEST_H_
@@ -0,0 +1,109 @@
+#include "Concurrent_skiplist_Test.h"
+
+namespace TinySTL {
+	namespace Concurrent_skiplistTest {
+
+		void testCase1() {
+			// 单线程语义，与std::map对照
+			std::mt19937 rng(1);
+			concurrent_skiplist_map<int, int> m;
+			std::map<int, int> ref;
+			for (int i = 0; i < 100000; ++i) {
+				int key = rng() % 5000;
+				switch (rng() % 3) {
+				case 0:
+					assert(m.insert_unique(pair<const int, int>(key, i)) == ref.insert(std::make_pair(key, i)).second);
+					break;
+				case 1:
+					assert(m.erase(key) == ref.erase(key));
+					break;
+				default: {
+					int out = -1;
+					auto it = ref.find(key);
+					assert(m.find(key, out) == (it != ref.end()));
+					assert(it == ref.end() || out == it->second);
+				}
+				}
+			}
+			assert(m.size() == ref.size());
+			auto it = ref.begin();
+			m.for_each([&](const pair<const int, int>& v) {
+				assert(v.first == it->first && v.second == it->second);
+				++it;
+			});
+			assert(it == ref.end());
+
+			size_t n = 0, expect = 0;
+			m.for_each(100, 200, [&](const pair<const int, int>& v) {
+				assert(v.first >= 100 && v.first < 200);
+				++n;
+			});
+			for (auto r = ref.lower_bound(100); r != ref.lower_bound(200); ++r)
+				++expect;
+			assert(n == expect);
+
+			m.clear();
+			assert(m.empty());
+			m.insert_unique(pair<const int, int>(1, 1));
+			assert(m.contains(1) && m.size() == 1);
+		}
+		void testCase2() {
+			// 8个线程同时插入、删除、查找，每个线程只修改属于自己的键值（key % T == t），用各自的std::set对照；
+			// 另一个线程不停地遍历，看到的序列必须严格递增
+			const int T = 8, OPS = 100000, K = 20000;
+			concurrent_skiplist_set<int> s;
+			std::vector<std::set<int>> local(T);
+			std::atomic<bool> stop(false);
+			std::vector<std::thread> writers;
+			for (int t = 0; t < T; ++t) {
+				writers.emplace_back([&, t] {
+					std::mt19937 rng(t + 1);
+					std::set<int>& ref = local[t];
+					for (int i = 0; i < OPS; ++i) {
+						int key = static_cast<int>(rng() % (K / T)) * T + t;
+						switch (rng() % 3) {
+						case 0:
+							assert(s.insert(key) == ref.insert(key).second);
+							break;
+						case 1:
+							assert(s.erase(key) == ref.erase(key));
+							break;
+						default:
+							assert(s.contains(key) == (ref.count(key) != 0));
+							s.contains(static_cast<int>(rng() % K));     // 别的线程正在修改的键值
+						}
+					}
+				});
+			}
+			std::thread reader([&] {
+				while (!stop.load()) {
+					int prev = -1;
+					s.for_each([&](int x) {
+						assert(x > prev);
+						prev = x;
+					});
+				}
+			});
+			for (auto& th : writers)
+				th.join();
+			stop.store(true);
+			reader.join();
+
+			std::set<int> all;
+			for (auto& ref : local)
+				all.insert(ref.begin(), ref.end());
+			assert(s.size() == all.size());
+			auto it = all.begin();
+			s.for_each([&](int x) {
+				assert(x == *it);
+				++it;
+			});
+			assert(it == all.end());
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+		}
+	}
+}
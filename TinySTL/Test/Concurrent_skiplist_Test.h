@@ -0,0 +1,25 @@
+#ifndef _CONCURRENT_SKIPLIST_TEST_H_
+#define _CONCURRENT_SKIPLIST_TEST_H_
+
+#include "../Concurrent_skiplist.h"
+#include "test_fun.h"
+
+#include <atomic>
+#include <cassert>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace TinySTL {
+	namespace Concurrent_skiplistTest {
+
+		void testCase1();
+		void testCase2();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_CONCURRENT_SKIPLIST_TEST_H_
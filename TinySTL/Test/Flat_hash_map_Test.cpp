@@ -0,0 +1,84 @@
+#include "Flat_hash_map_Test.h"
+
+namespace TinySTL {
+	namespace Flat_hash_mapTest {
+
+		void testCase1() {
+			flat_hash_map<int, int> m;
+			assert(m.empty() && m.begin() == m.end() && m.find(1) == m.end());
+			for (int i = 0; i < 1000; ++i)
+				m[i] = i * 2;
+			assert(m.size() == 1000);
+			for (int i = 0; i < 1000; ++i)
+				assert(m.find(i)->second == i * 2 && m.count(i) == 1);
+			assert(m.count(1000) == 0);
+
+			auto r = m.insert(pair<const int, int>(5, 0));
+			assert(!r.second && r.first->second == 10);
+		}
+		void testCase2() {
+			flat_hash_map<int, int> m;
+			for (int i = 0; i < 1000; ++i)
+				m[i] = i;
+			for (int i = 0; i < 1000; i += 2)
+				assert(m.erase(i) == 1);
+			assert(m.erase(0) == 0 && m.size() == 500);
+			m.erase(m.find(1));
+			assert(m.find(1) == m.end() && m.size() == 499);
+
+			int n = 0;
+			for (auto it = m.begin(); it != m.end(); ++it, ++n)
+				assert(it->first % 2 == 1 && it->first == it->second);
+			assert(n == 499);
+		}
+		void testCase3() {
+			// 与std::unordered_map对照，随机插入、删除，墓碑会触发按原大小重建
+			std::mt19937 rng(42);
+			flat_hash_map<int, int> m;
+			std::unordered_map<int, int> ref;
+			for (int i = 0; i < 100000; ++i) {
+				int key = rng() % 2000;
+				if (rng() % 2) {
+					m[key] = i;
+					ref[key] = i;
+				}
+				else {
+					assert(m.erase(key) == ref.erase(key));
+				}
+				assert(m.size() == ref.size());
+			}
+			for (auto it = m.begin(); it != m.end(); ++it)
+				assert(ref[it->first] == it->second);
+		}
+		void testCase4() {
+			flat_hash_set<int> s1, s2;
+			for (int i = 0; i < 100; ++i)
+				s1.insert(i);
+			for (int i = 99; i >= 0; --i)
+				s2.insert(i);
+			assert(s1 == s2);
+			s2.erase(50);
+			assert(s1 != s2);
+
+			flat_hash_set<int> s3(s1);
+			assert(s3 == s1);
+			s3.clear();
+			assert(s3.empty() && s3.begin() == s3.end());
+			s3.swap(s1);
+			assert(s1.empty() && s3.size() == 100);
+
+			flat_hash_map<std::string, int, std::hash<std::string>> words;
+			const char* text[] = { "a", "b", "a", "c", "b", "a" };
+			for (auto w : text)
+				++words[w];
+			assert(words["a"] == 3 && words["b"] == 2 && words["c"] == 1 && words.size() == 3);
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+			testCase4();
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#ifndef _FLAT_HASH_MAP_TEST_H_
+#define _FLAT_HASH_MAP_TEST_H_
+
+#include "../Flat_hash_map.h"
+#include "../Flat_hash_set.h"
+#include "test_fun.h"
+
+#include <cassert>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace TinySTL {
+	namespace Flat_hash_mapTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testCase4();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_FLAT_HASH_MAP_TEST_H_
@@ -0,0 +1,73 @@
+#include "Flat_map_Test.h"
+
+namespace TinySTL {
+	namespace Flat_mapTest {
+
+		void testCase1() {
+			// 乱序插入，元素都要插到vector中间；reserve之后size() == capacity() - 1时也不能越界
+			flat_set<int> s;
+			s.reserve(64);
+			for (int i = 10; i <= 630; i += 10)
+				s.insert(i);
+			assert(s.size() == 63 && s.capacity() == 64);
+			assert(s.insert(5).second && !s.insert(5).second);
+			assert(s.size() == 64 && *s.begin() == 5);
+			int prev = 0;
+			for (auto it = s.begin(); it != s.end(); ++it) {
+				assert(*it > prev);
+				prev = *it;
+			}
+		}
+		void testCase2() {
+			// 与std::map对照，随机的operator[]、insert、erase
+			std::mt19937 rng(42);
+			flat_map<int, int> m;
+			std::map<int, int> ref;
+			for (int i = 0; i < 20000; ++i) {
+				int key = rng() % 1000;
+				switch (rng() % 3) {
+				case 0:
+					m[key] = i;
+					ref[key] = i;
+					break;
+				case 1:
+					assert(m.insert(pair<int, int>(key, i)).second == ref.insert(std::make_pair(key, i)).second);
+					break;
+				default:
+					assert(m.erase(key) == ref.erase(key));
+				}
+				assert(m.size() == ref.size());
+			}
+			auto it = m.begin();
+			for (auto r = ref.begin(); r != ref.end(); ++r, ++it)
+				assert(it->first == r->first && it->second == r->second);
+			assert(it == m.end());
+		}
+		void testCase3() {
+			// insert(first, last)：已有的key优先，新元素中重复的只保留一个
+			flat_map<int, int> m;
+			for (int i = 100; i > 0; i -= 2)
+				m[i] = i;
+			pair<int, int> v[] = { pair<int, int>(3, 0), pair<int, int>(4, 0), pair<int, int>(1, 0), pair<int, int>(3, 1), pair<int, int>(101, 0) };
+			m.insert(v, v + 5);
+			assert(m.size() == 53);
+			assert(m[4] == 4 && m[3] == 0 && m[1] == 0 && m[101] == 0);
+			assert(m.lower_bound(5)->first == 6 && m.upper_bound(100)->first == 101);
+
+			std::set<int> ref;
+			flat_set<int> s;
+			for (int i = 0; i < 1000; ++i) {
+				int x = (i * 7919) % 1009;
+				s.insert(x);
+				ref.insert(x);
+			}
+			assert(Test::container_equal(s, ref));
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+		}
+	}
+}
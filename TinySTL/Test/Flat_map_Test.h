@@ -0,0 +1,24 @@
+#ifndef _FLAT_MAP_TEST_H_
+#define _FLAT_MAP_TEST_H_
+
+#include "../Flat_map.h"
+#include "../Flat_set.h"
+#include "test_fun.h"
+
+#include <cassert>
+#include <map>
+#include <random>
+#include <set>
+
+namespace TinySTL {
+	namespace Flat_mapTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_FLAT_MAP_TEST_H_
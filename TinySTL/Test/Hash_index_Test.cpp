@@ -0,0 +1,124 @@
+#include "Hash_index_Test.h"
+
+namespace TinySTL {
+	namespace Hash_indexTest {
+
+		const char* const path = "hash_index_test.idx";
+
+		// 把整个文件读到按8字节对齐的内存中，供attach使用、修改
+		std::vector<unsigned long long> load_file() {
+			mapped_file f;
+			assert(f.open(path));
+			std::vector<unsigned long long> buf((f.size() + 7) / 8);
+			memcpy(buf.data(), f.data(), f.size());
+			return buf;
+		}
+		size_t file_size() {
+			mapped_file f;
+			assert(f.open(path));
+			return f.size();
+		}
+
+		void testCase1() {
+			// hash_map写成索引文件，映射进来之后逐个查找
+			hash_map<int, long long> m;
+			for (int i = 0; i < 10000; ++i)
+				m[i * 7] = static_cast<long long>(i) * i;
+			assert(write_hash_index(path, m));
+
+			hash_index<int, long long> idx;
+			assert(idx.open(path) && idx.size() == 10000);
+			for (int i = 0; i < 10000; ++i) {
+				const long long* v = idx.find(i * 7);
+				assert(v != nullptr && *v == static_cast<long long>(i) * i);
+			}
+			assert(idx.find(1) == nullptr && idx.find(-7) == nullptr && idx.find(70000) == nullptr);
+			assert(idx.count(6) == 0 && idx.count(7) == 1);
+
+			// 通过mapped_file自己映射，再attach
+			mapped_file f;
+			assert(f.open(path));
+			hash_index<int, long long> idx2;
+			assert(idx2.attach(f.data(), f.size()) && *idx2.find(700) == 10000);
+
+			hash_index<int, long long> other;
+			assert(!other.open("hash_index_test_missing.idx") && !other.is_open() && other.find(0) == nullptr);
+		}
+		void testCase2() {
+			// 文件正被映射时重写同一个路径：旧的映射不受影响，重新打开才看到新的内容
+			pair<int, long long> a[] = { pair<int, long long>(1, 10), pair<int, long long>(2, 20) };
+			pair<int, long long> b[] = { pair<int, long long>(3, 30) };
+			assert((write_hash_index<int, long long>(path, a, a + 2, 2)));
+			hash_index<int, long long> old_idx(path);
+			assert(old_idx.is_open());
+
+			assert((write_hash_index<int, long long>(path, b, b + 1, 1)));
+			assert(*old_idx.find(1) == 10 && *old_idx.find(2) == 20 && old_idx.find(3) == nullptr);
+			hash_index<int, long long> new_idx(path);
+			assert(new_idx.size() == 1 && *new_idx.find(3) == 30 && new_idx.find(1) == nullptr);
+
+			FILE* tmp = fopen("hash_index_test.idx.tmp", "rb");     // 临时文件已经改名，不会留下
+			assert(tmp == nullptr);
+		}
+		void testCase3() {
+			// attach拒绝不合法的文件头、截断的数据
+			pair<int, long long> a[] = { pair<int, long long>(1, 10), pair<int, long long>(2, 20), pair<int, long long>(3, 30) };
+			assert((write_hash_index<int, long long>(path, a, a + 3, 3)));
+			const size_t size = file_size();
+			std::vector<unsigned long long> good = load_file();
+			hash_index<int, long long> idx;
+			assert(idx.attach(good.data(), size) && *idx.find(2) == 20);
+
+			hash_index_header header;
+			memcpy(&header, good.data(), sizeof(header));
+			std::vector<unsigned long long> bad;
+			auto with_header = [&](const hash_index_header& h) -> const void* {
+				bad = good;
+				memcpy(bad.data(), &h, sizeof(h));
+				return bad.data();
+			};
+
+			hash_index_header h = header;
+			h.magic[0] = 'X';
+			assert(!idx.attach(with_header(h), size));
+			h = header;
+			h.endian = 0x04030201u;
+			assert(!idx.attach(with_header(h), size));
+			h = header;
+			h.key_size = 8;
+			assert(!idx.attach(with_header(h), size));
+			h = header;
+			h.value_size = 4;
+			assert(!idx.attach(with_header(h), size));
+			h = header;
+			h.slot_size = 12;
+			assert(!idx.attach(with_header(h), size));
+			h = header;
+			h.capacity = 12;        // 不是2的幂
+			assert(!idx.attach(with_header(h), size));
+			h = header;
+			h.count = h.capacity;   // 没有空位
+			assert(!idx.attach(with_header(h), size));
+			h = header;
+			h.slots_offset += 8;    // slots超出文件
+			assert(!idx.attach(with_header(h), size));
+			assert(!idx.attach(good.data(), size - 1));
+			assert(!idx.attach(good.data(), sizeof(hash_index_header) - 1));
+
+			// ctrl不在校验范围之内：全部改成非空之后，查找不存在的key也要能停下来
+			bad = good;
+			memset(reinterpret_cast<char*>(bad.data()) + header.ctrl_offset, 0x80, static_cast<size_t>(header.capacity));
+			assert(idx.attach(bad.data(), size));
+			assert(idx.find(12345) == nullptr);
+
+			idx.close();
+			remove(path);
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+		}
+	}
+}
@@ -0,0 +1,24 @@
+#ifndef _HASH_INDEX_TEST_H_
+#define _HASH_INDEX_TEST_H_
+
+#include "../Hash_index.h"
+#include "../hash_map.h"
+#include "test_fun.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace TinySTL {
+	namespace Hash_indexTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_HASH_INDEX_TEST_H_
@@ -0,0 +1,154 @@
+#include "Hash_map_Test.h"
+
+namespace TinySTL {
+	namespace Hash_mapTest {
+
+		// 逐个查找ref中的元素，并且遍历时每个元素恰好出现一次
+		template<class Map>
+		void check_equal(const Map& m, const std::unordered_map<int, int>& ref) {
+			assert(m.size() == ref.size());
+			for (auto r = ref.begin(); r != ref.end(); ++r) {
+				auto it = m.find(r->first);
+				assert(it != m.end() && it->second == r->second);
+			}
+			std::set<int> seen;
+			for (auto it = m.begin(); it != m.end(); ++it) {
+				assert(seen.insert(it->first).second);
+				assert(ref.count(it->first) == 1);
+			}
+			assert(seen.size() == ref.size());
+		}
+
+		// 同样的随机操作序列，中途强制rehash、shrink_to_fit、compact、修改max_load_factor
+		template<class Policy, bool CacheHash>
+		void random_ops(bool incremental) {
+			std::mt19937 rng(1);
+			hash_map<int, int, hash<int>, equal_to<int>, Policy, CacheHash> m(16);
+			m.set_incremental_rehash(incremental);
+			std::unordered_map<int, int> ref;
+			for (int i = 0; i < 60000; ++i) {
+				int key = rng() % 8000 - 1000;
+				switch (rng() % 6) {
+				case 0:
+				case 1:
+					assert(m.insert(pair<const int, int>(key, i)).second == ref.insert(std::make_pair(key, i)).second);
+					break;
+				case 2:
+					m[key] = i;
+					ref[key] = i;
+					break;
+				case 3: {
+					auto it = m.find(key);
+					assert((it == m.end()) == (ref.count(key) == 0));
+					if (it != m.end()) {
+						m.erase(it);
+						ref.erase(key);
+					}
+					break;
+				}
+				default: {
+					auto it = m.find(key);
+					auto r = ref.find(key);
+					assert((it == m.end()) == (r == ref.end()));
+					assert(r == ref.end() || it->second == r->second);
+					assert(m.count(key) == ref.count(key));
+				}
+				}
+				switch (i % 10000) {
+				case 1000:
+					m.rehash(rng() % 50000);        // 可能变大，也可能变小
+					break;
+				case 3000:
+					m.shrink_to_fit();
+					break;
+				case 5000:
+					m.compact();
+					break;
+				case 7000:
+					m.max_load_factor(i % 20000 == 7000 ? 0.25f : 4.0f);
+					break;
+				case 9000:
+					check_equal(m, ref);
+					break;
+				}
+			}
+			check_equal(m, ref);
+			m.compact();
+			check_equal(m, ref);
+			m.clear();
+			assert(m.empty() && m.begin() == m.end());
+		}
+
+		typedef hashtable<pair<const int, int>, int, hash<int>, select1st<pair<const int, int>>, equal_to<int>, prime_rehash_policy, false> table;
+
+		void testCase1() {
+			// 渐进式rehash开、关，是否保存hash值，两种rehash_policy，结果都与std::unordered_map相同
+			random_ops<prime_rehash_policy, false>(false);
+			random_ops<prime_rehash_policy, false>(true);
+			random_ops<prime_rehash_policy, true>(false);
+			random_ops<prime_rehash_policy, true>(true);
+			random_ops<pow2_rehash_policy, false>(false);
+			random_ops<pow2_rehash_policy, true>(true);
+		}
+		void testCase2() {
+			// 渐进式rehash进行中：遍历、查找、插入、删除要同时照顾旧buckets和新buckets
+			std::mt19937 rng(2);
+			table t(16, hash<int>(), equal_to<int>());
+			t.set_incremental_rehash(true);
+			std::unordered_map<int, int> ref;
+			int migrations = 0;
+			for (int i = 0; i < 200000 && migrations < 20; ++i) {
+				int key = rng() % 100000;
+				const bool was_rehashing = t.is_rehashing();
+				if (rng() % 4 != 0) {
+					t.insert_unique(pair<const int, int>(key, i));
+					ref.insert(std::make_pair(key, i));
+				}
+				else {
+					auto it = t.find(key);
+					if (it != t.end()) {
+						t.erase(it);
+						ref.erase(key);
+					}
+				}
+				if (!was_rehashing && t.is_rehashing()) {
+					++migrations;
+					check_equal(t, ref);        // 刚开始搬移，几乎所有节点都还在旧buckets中
+				}
+				else if (t.is_rehashing() && rng() % 1024 == 0)
+					check_equal(t, ref);        // 搬到一半
+			}
+			assert(migrations >= 10);
+			t.finish_rehash();
+			assert(!t.is_rehashing());
+			check_equal(t, ref);
+		}
+		void testCase3() {
+			// find_batch与逐个find的结果相同，包括不存在的key、rehash进行中的表
+			std::mt19937 rng(3);
+			for (int incremental = 0; incremental < 2; ++incremental) {
+				table t(16, hash<int>(), equal_to<int>());
+				t.set_incremental_rehash(incremental != 0);
+				for (int round = 0; round < 40; ++round) {
+					for (int i = 0; i < 500; ++i) {
+						int key = rng() % 30000;
+						t.insert_unique(pair<const int, int>(key, key));
+					}
+					std::vector<int> keys(rng() % 100);     // 长度不一定是batch_size的倍数
+					for (auto& k : keys)
+						k = rng() % 40000;
+					std::vector<table::iterator> result(keys.size(), t.end());
+					assert(t.find_batch(keys.begin(), keys.end(), result.begin()) == result.end());
+					for (size_t i = 0; i != keys.size(); ++i)
+						assert(result[i] == t.find(keys[i]));
+				}
+			}
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+		}
+	}
+}
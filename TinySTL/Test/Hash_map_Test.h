@@ -0,0 +1,24 @@
+#ifndef _HASH_MAP_TEST_H_
+#define _HASH_MAP_TEST_H_
+
+#include "../hash_map.h"
+#include "test_fun.h"
+
+#include <cassert>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace TinySTL {
+	namespace Hash_mapTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_HASH_MAP_TEST_H_
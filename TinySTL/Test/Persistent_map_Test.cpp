@@ -0,0 +1,144 @@
+#include "Persistent_map_Test.h"
+
+namespace TinySTL {
+	namespace Persistent_mapTest {
+
+		// 记录还活着的对象个数，用来检查快照释放之后节点都被回收了
+		std::atomic<long> live(0);
+		struct counted {
+			int v;
+			counted(int x = 0) : v(x) { ++live; }
+			counted(const counted& x) : v(x.v) { ++live; }
+			~counted() { --live; }
+		};
+		typedef persistent_map<int, counted> map_type;
+
+		void check_equal(const map_type& m, const std::map<int, int>& ref) {
+			assert(m.size() == ref.size());
+			auto it = m.begin();
+			for (auto r = ref.begin(); r != ref.end(); ++r, ++it) {
+				assert(it != m.end());
+				assert(it->first == r->first && it->second.v == r->second);
+			}
+			assert(it == m.end());
+		}
+
+		void testCase1() {
+			// 随机修改，与std::map对照；每隔一段取一个快照，之后的修改不能影响已有的快照
+			std::mt19937 rng(7);
+			{
+				map_type m;
+				std::map<int, int> ref;
+				std::vector<map_type> snaps;
+				std::vector<std::map<int, int>> snap_refs;
+				for (int i = 0; i < 40000; ++i) {
+					int key = rng() % 3000, op = rng() % 10;
+					if (op < 4)
+						assert(m.insert(map_type::value_type(key, counted(i))) == ref.insert(std::make_pair(key, i)).second);
+					else if (op < 6) {
+						assert(m.insert_or_assign(key, counted(i)) == (ref.count(key) == 0));
+						ref[key] = i;
+					}
+					else if (op < 9)
+						assert(m.erase(key) == ref.erase(key));
+					else {
+						auto r = ref.find(key);
+						assert((m.find(key) == m.end()) == (r == ref.end()));
+						assert(r == ref.end() || m.get(key)->v == r->second);
+						auto lb = m.lower_bound(key);
+						auto rl = ref.lower_bound(key);
+						assert((lb == m.end()) == (rl == ref.end()));
+						assert(rl == ref.end() || lb->first == rl->first);
+					}
+					if (i % 5000 == 0) {
+						snaps.push_back(m.snapshot());
+						snap_refs.push_back(ref);
+					}
+				}
+				check_equal(m, ref);
+				for (size_t i = 0; i != snaps.size(); ++i)
+					check_equal(snaps[i], snap_refs[i]);
+
+				while (!ref.empty()) {
+					assert(m.erase(ref.begin()->first) == 1);
+					ref.erase(ref.begin());
+				}
+				assert(m.empty());
+				for (size_t i = 0; i != snaps.size(); ++i)
+					check_equal(snaps[i], snap_refs[i]);
+			}
+			assert(live == 0);     // 所有版本都析构之后，共享的节点全部回收
+		}
+		void testCase2() {
+			// 没有快照时就地修改，不复制节点；有快照时只复制O(logN)个节点，释放快照后回到原来的个数
+			map_type m;
+			for (int i = 0; i < 1000; ++i)
+				m.insert(map_type::value_type(i, counted(i)));
+			long before = live;
+			m.erase(500);
+			m.insert(map_type::value_type(5000, counted(1)));
+			assert(live == before);
+
+			{
+				map_type s = m.snapshot();
+				before = live;
+				m.insert(map_type::value_type(6000, counted(1)));
+				assert(live - before > 1 && live - before < 64);
+				assert(s.size() == 1000 && m.size() == 1001 && !s.contains(6000));
+				m.erase(6000);
+			}
+			assert(live == 1000);
+			m.clear();
+			assert(live == 0);
+		}
+		void testCase3() {
+			// 一个线程修改并发布快照，三个线程同时遍历拿到的快照
+			{
+				map_type m;
+				for (int i = 0; i < 10000; ++i)
+					m.insert(map_type::value_type(i, counted(i)));
+				std::vector<map_type> published(4, m.snapshot());
+				std::mutex mtx;
+				std::atomic<bool> stop(false);
+				std::vector<std::thread> readers;
+				for (int t = 0; t < 3; ++t) {
+					readers.emplace_back([&, t] {
+						for (size_t k = t; !stop.load(); ++k) {
+							map_type s;
+							{
+								std::lock_guard<std::mutex> guard(mtx);
+								s = published[k % 4];
+							}
+							size_t n = 0;
+							int prev = -1;
+							for (auto it = s.begin(); it != s.end(); ++it, ++n) {
+								assert(it->first > prev);
+								prev = it->first;
+							}
+							assert(n == s.size());
+						}
+					});
+				}
+				for (int i = 0; i < 20000; ++i) {
+					m.erase(i % 10000);
+					m.insert(map_type::value_type(i % 10000, counted(i)));
+					if (i % 100 == 0) {
+						map_type s = m.snapshot();
+						std::lock_guard<std::mutex> guard(mtx);
+						published[i / 100 % 4] = s;
+					}
+				}
+				stop.store(true);
+				for (auto& th : readers)
+					th.join();
+			}
+			assert(live == 0);
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+		}
+	}
+}
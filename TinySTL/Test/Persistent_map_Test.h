@@ -0,0 +1,26 @@
+#ifndef _PERSISTENT_MAP_TEST_H_
+#define _PERSISTENT_MAP_TEST_H_
+
+#include "../Persistent_map.h"
+#include "test_fun.h"
+
+#include <atomic>
+#include <cassert>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace TinySTL {
+	namespace Persistent_mapTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_PERSISTENT_MAP_TEST_H_
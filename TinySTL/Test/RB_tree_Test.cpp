@@ -0,0 +1,261 @@
+#include "RB_tree_Test.h"
+
+namespace TinySTL {
+	namespace RB_treeTest {
+
+		// 直接从rb_tree派生，检查红黑树的性质：红节点没有红孩子、各路径黑高相同、parent指针、
+		// 根为黑且parent为header、leftmost/rightmost，OrderStat为true时还检查每个节点的size
+		template<bool OrderStat>
+		struct checked_tree : rb_tree<int, int, identity<int>, less<int>, OrderStat> {
+			typedef rb_tree<int, int, identity<int>, less<int>, OrderStat> base;
+			typedef typename base::tree_node tree_node;
+
+			void check_size(tree_node* x, size_t n, rb_tree_order_tag<true>) { assert(x->size == n); }
+			void check_size(tree_node*, size_t, rb_tree_order_tag<false>) { }
+			int black_height(tree_node* x, size_t& n) {
+				if (x == nullptr) {
+					n = 0;
+					return 1;
+				}
+				if (x->color == RED) {
+					assert(x->left == nullptr || x->left->color == BLACK);
+					assert(x->right == nullptr || x->right->color == BLACK);
+				}
+				if (x->left != nullptr)
+					assert(x->left->parent == x);
+				if (x->right != nullptr)
+					assert(x->right->parent == x);
+				size_t nl, nr;
+				int hl = black_height(x->left, nl);
+				int hr = black_height(x->right, nr);
+				assert(hl == hr);
+				n = nl + nr + 1;
+				check_size(x, n, typename base::order_tag());
+				return hl + (x->color == BLACK ? 1 : 0);
+			}
+			void verify() {
+				size_t n;
+				black_height(this->root(), n);
+				assert(n == this->size());
+				if (this->root() == nullptr) {
+					assert(this->leftmost() == this->header && this->rightmost() == this->header);
+					return;
+				}
+				assert(this->root()->color == BLACK && this->root()->parent == this->header);
+				assert(this->leftmost() == base::min_value_node(this->root()));
+				assert(this->rightmost() == base::max_value_node(this->root()));
+			}
+		};
+
+		template<bool OrderStat, class Container>
+		void check_equal(checked_tree<OrderStat>& t, const Container& ref) {
+			t.verify();
+			assert(t.size() == ref.size());
+			assert(std::equal(ref.begin(), ref.end(), t.begin()));
+		}
+
+		template<bool OrderStat>
+		void random_insert_erase() {
+			std::mt19937 rng(1);
+			checked_tree<OrderStat> u, e;
+			std::set<int> ru;
+			std::multiset<int> re;
+			for (int i = 0; i < 20000; ++i) {
+				int key = rng() % 2000;
+				if (rng() % 3 != 0) {
+					assert(u.insert_unique(key).second == ru.insert(key).second);
+					e.insert_equal(key);
+					re.insert(key);
+				}
+				else {
+					assert(u.erase(key) == ru.erase(key));
+					assert(e.erase(key) == re.erase(key));
+				}
+				if (i % 1000 == 0) {
+					check_equal(u, ru);
+					check_equal(e, re);
+				}
+			}
+			check_equal(u, ru);
+			check_equal(e, re);
+		}
+		template<bool OrderStat>
+		void bulk_and_hint_insert() {
+			// 有序区间整块建树，无序的尾部逐个插入；hint插入与普通插入结果相同
+			std::mt19937 rng(2);
+			for (int n = 0; n < 200; ++n) {
+				std::vector<int> v(n);
+				for (int i = 0; i < n; ++i)
+					v[i] = i / 3;
+				if (n > 5)
+					v[n * 2 / 3] = -1;
+				checked_tree<OrderStat> u, e;
+				u.insert_unique(v.begin(), v.end());
+				e.insert_equal(v.begin(), v.end());
+				check_equal(u, std::set<int>(v.begin(), v.end()));
+				check_equal(e, std::multiset<int>(v.begin(), v.end()));
+			}
+			checked_tree<OrderStat> t;
+			std::multiset<int> ref;
+			for (int i = 0; i < 3000; ++i) {
+				int key = rng() % 500;
+				t.insert_equal(t.lower_bound(key), key);       // hint正好是插入位置
+				t.insert_equal(t.begin(), key + 1);            // hint离插入位置很远
+				ref.insert(key);
+				ref.insert(key + 1);
+			}
+			check_equal(t, ref);
+		}
+		template<bool OrderStat>
+		void order_statistics() {
+			std::mt19937 rng(3);
+			checked_tree<OrderStat> t;
+			std::set<int> ref;
+			for (int i = 0; i < 3000; ++i) {
+				int key = rng() % 10000;
+				t.insert_unique(key);
+				ref.insert(key);
+			}
+			t.verify();
+			size_t i = 0;
+			for (auto it = ref.begin(); it != ref.end(); ++it, ++i) {
+				assert(*t.nth(i) == *it);
+				assert(t.rank(*it) == i);
+				assert(t.index_of(t.find(*it)) == i);
+			}
+			assert(t.nth(ref.size()) == t.end() && t.index_of(t.end()) == t.size());
+			for (int k = 0; k < 1000; ++k) {
+				int lo = rng() % 10000, hi = rng() % 10000;
+				size_t n = lo < hi ? std::distance(ref.lower_bound(lo), ref.lower_bound(hi)) : 0;
+				assert(t.rank(lo) == static_cast<size_t>(std::distance(ref.begin(), ref.lower_bound(lo))));
+				assert(t.count_range(lo, hi) == n);
+				auto r = t.range(lo, hi);
+				size_t m = 0;
+				for (auto it = r.first; it != r.last; ++it)
+					++m;
+				assert(m == n);
+				if (lo < hi)
+					assert(t.distance(t.lower_bound(lo), t.lower_bound(hi)) == static_cast<ptrdiff_t>(n));
+			}
+		}
+
+		void testCase1() {
+			// 随机插入、删除，与std::set、std::multiset对照，并检查红黑树的性质
+			random_insert_erase<false>();
+			random_insert_erase<true>();
+		}
+		void testCase2() {
+			bulk_and_hint_insert<false>();
+			bulk_and_hint_insert<true>();
+		}
+		void testCase3() {
+			// rank、nth、index_of、count_range
+			order_statistics<false>();
+			order_statistics<true>();
+
+			set<int, less<int>, true> s;
+			for (int i = 0; i < 100; ++i)
+				s.insert(i * 2);
+			assert(s.rank(51) == 26 && *s.nth(99) == 198 && s.count_range(10, 20) == 5);
+		}
+		void testCase4() {
+			// 集合运算，两棵树大小悬殊或相近，结果与std::set_*对照；参数x运算之后为空树
+			std::mt19937 rng(4);
+			int sizes[][2] = { { 0, 0 }, { 0, 50 }, { 50, 0 }, { 1, 1000 }, { 1000, 3 }, { 500, 700 }, { 3000, 3000 } };
+			for (auto& sz : sizes) {
+				for (int op = 0; op < 3; ++op) {
+					checked_tree<true> a, b;
+					std::set<int> ra, rb;
+					for (int i = 0; i < sz[0]; ++i) {
+						int key = rng() % 5000;
+						a.insert_unique(key);
+						ra.insert(key);
+					}
+					for (int i = 0; i < sz[1]; ++i) {
+						int key = rng() % 5000;
+						b.insert_unique(key);
+						rb.insert(key);
+					}
+					std::vector<int> ref;
+					if (op == 0) {
+						a.set_union(b);
+						std::set_union(ra.begin(), ra.end(), rb.begin(), rb.end(), std::back_inserter(ref));
+					}
+					else if (op == 1) {
+						a.set_intersection(b);
+						std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(), std::back_inserter(ref));
+					}
+					else {
+						a.set_difference(b);
+						std::set_difference(ra.begin(), ra.end(), rb.begin(), rb.end(), std::back_inserter(ref));
+					}
+					check_equal(a, ref);
+					b.verify();
+					assert(b.empty());
+				}
+			}
+
+			set<int> x, y;
+			for (int i = 0; i < 10; ++i) {
+				x.insert(i);
+				y.insert(i + 5);
+			}
+			x.set_union(y);
+			assert(x.size() == 15 && y.empty());
+		}
+		void testCase5() {
+			// extract、insert(node_type&&)、merge：节点在两棵树之间转移
+			set<int> a, b;
+			for (int i = 0; i < 100; ++i)
+				a.insert(i);
+			for (int i = 50; i < 150; ++i)
+				b.insert(i);
+
+			auto nh = a.extract(10);
+			assert(!nh.empty() && nh.value() == 10 && a.size() == 99 && a.find(10) == a.end());
+			assert(a.extract(10).empty());
+			assert(b.insert(std::move(nh)).second && nh.empty() && b.count(10) == 1);
+
+			nh = b.extract(b.find(60));
+			assert(a.insert(std::move(nh)).second == false && !nh.empty());   // a中已有60，节点留在nh中
+
+			a.merge(b);                 // b中a没有的键值都转移过来，重复的留在b中
+			assert(a.size() == 150 && b.size() == 49);
+			for (auto it = b.begin(); it != b.end(); ++it)
+				assert(*it >= 50 && *it < 100 && a.count(*it) == 1);
+
+			multiset<int> m1, m2;
+			for (int i = 0; i < 50; ++i) {
+				m1.insert(i % 10);
+				m2.insert(i % 7);
+			}
+			m1.merge(m2);
+			assert(m1.size() == 100 && m2.empty() && m1.count(3) == 5 + 7);
+
+			checked_tree<true> t, u;
+			std::multiset<int> ref;
+			for (int i = 0; i < 500; ++i) {
+				t.insert_equal(i % 37);
+				u.insert_equal(i % 41);
+				ref.insert(i % 37);
+				ref.insert(i % 41);
+			}
+			for (int i = 0; i < 41; i += 3) {
+				auto h = u.extract(i);
+				assert(t.insert_equal(std::move(h)) != t.end() && h.empty());
+			}
+			t.merge_equal(u);
+			check_equal(t, ref);
+			u.verify();
+			assert(u.empty());
+		}
+
+		void testAllCases() {
+			testCase1();
+			testCase2();
+			testCase3();
+			testCase4();
+			testCase5();
+		}
+	}
+}
@@ -0,0 +1,29 @@
+#ifndef _RB_TREE_TEST_H_
+#define _RB_TREE_TEST_H_
+
+#include "../RB_tree.h"
+#include "../Set.h"
+#include "../Multiset.h"
+#include "test_fun.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace TinySTL {
+	namespace RB_treeTest {
+
+		void testCase1();
+		void testCase2();
+		void testCase3();
+		void testCase4();
+		void testCase5();
+		void testAllCases();
+	}
+}
+
+
+#endif // !_RB_TREE_TEST_H_
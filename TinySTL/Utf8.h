@@ -0,0 +1,158 @@
+#ifndef _UTF8_H_
+#define _UTF8_H_
+
+/*
+*	Author  @yyehl
+*/
+
+#include "Iterator.h"
+#include "String_view.h"
+
+/*
+*  UTF-8 的校验、码点计数与按码点遍历，string 可以隐式转换为 string_view 直接使用
+*
+*  utf8_validate ：检查是否为合法的UTF-8（拒绝过长编码、代理区U+D800~U+DFFF、大于U+10FFFF的码点、
+*                  不完整的序列以及多余的后续字节）
+*                  x86/x64上运行时检测CPU，支持SSSE3/AVX2时使用simdjson的查表法（Keiser & Lemire），
+*                  每次检查16/32个字节，纯ASCII的块只需要一次movemask，不需要打开编译选项；
+*                  否则ASCII部分每次跳过16个（SSE2）或8个字节，只有多字节序列逐字节检查
+*  utf8_length   ：码点个数，即不是后续字节（10xxxxxx）的字节个数，要求输入合法
+*  utf8_iterator ：双向迭代器，解引用得到char32_t的码点，要求输入合法（先用utf8_validate检查）
+*/
+
+namespace TinySTL
+{
+	bool utf8_validate(const char* s, size_t n);
+	size_t utf8_length(const char* s, size_t n);
+
+	inline bool utf8_validate(const string_view& sv) { return utf8_validate(sv.data(), sv.size()); }
+	inline size_t utf8_length(const string_view& sv) { return utf8_length(sv.data(), sv.size()); }
+
+	// 根据首字节得到序列的长度，后续字节和非法的首字节返回1
+	inline int utf8_sequence_length(unsigned char lead)
+	{
+		if (lead < 0xC0) return 1;
+		if (lead < 0xE0) return 2;
+		if (lead < 0xF0) return 3;
+		return lead < 0xF8 ? 4 : 1;
+	}
+
+	// 解码p开始的一个码点，p必须指向合法序列的首字节
+	inline char32_t utf8_decode(const char* p)
+	{
+		const unsigned char* s = reinterpret_cast<const unsigned char*>(p);
+		switch (utf8_sequence_length(s[0]))
+		{
+		case 2: return ((s[0] & 0x1Fu) << 6) | (s[1] & 0x3Fu);
+		case 3: return ((s[0] & 0x0Fu) << 12) | ((s[1] & 0x3Fu) << 6) | (s[2] & 0x3Fu);
+		case 4: return ((s[0] & 0x07u) << 18) | ((s[1] & 0x3Fu) << 12) | ((s[2] & 0x3Fu) << 6) | (s[3] & 0x3Fu);
+		default: return s[0];
+		}
+	}
+
+	// 把码点c编码写入out（至少4个字节的空间），返回写入的字节数，c不合法时返回0
+	inline size_t utf8_encode(char32_t c, char* out)
+	{
+		if (c < 0x80)
+		{
+			out[0] = static_cast<char>(c);
+			return 1;
+		}
+		if (c < 0x800)
+		{
+			out[0] = static_cast<char>(0xC0 | (c >> 6));
+			out[1] = static_cast<char>(0x80 | (c & 0x3F));
+			return 2;
+		}
+		if (c < 0x10000)
+		{
+			if (c >= 0xD800 && c <= 0xDFFF)   // 代理区不能单独编码
+				return 0;
+			out[0] = static_cast<char>(0xE0 | (c >> 12));
+			out[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			out[2] = static_cast<char>(0x80 | (c & 0x3F));
+			return 3;
+		}
+		if (c < 0x110000)
+		{
+			out[0] = static_cast<char>(0xF0 | (c >> 18));
+			out[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+			out[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			out[3] = static_cast<char>(0x80 | (c & 0x3F));
+			return 4;
+		}
+		return 0;
+	}
+
+	/*********************** class utf8_iterator *****************************/
+	class utf8_iterator
+	{
+	public:
+		typedef bidirectional_iterator_tag   iterator_category;
+		typedef char32_t                     value_type;
+		typedef ptrdiff_t                    difference_type;
+		typedef const char32_t*              pointer;
+		typedef char32_t                     reference;    // 码点是解码出来的，只能按值返回
+
+	private:
+		const char* cur;
+
+	public:
+		utf8_iterator() : cur(nullptr) { }
+		explicit utf8_iterator(const char* p) : cur(p) { }
+
+		// 当前码点在原字符串中的位置
+		const char* base() const { return cur; }
+
+		char32_t operator * () const { return utf8_decode(cur); }
+
+		utf8_iterator& operator ++ ()
+		{
+			cur += utf8_sequence_length(static_cast<unsigned char>(*cur));
+			return *this;
+		}
+		utf8_iterator operator ++ (int)
+		{
+			utf8_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+		utf8_iterator& operator -- ()
+		{
+			do                         // 跳过后续字节，回到上一个首字节
+			{
+				--cur;
+			} while ((static_cast<unsigned char>(*cur) & 0xC0) == 0x80);
+			return *this;
+		}
+		utf8_iterator operator -- (int)
+		{
+			utf8_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		bool operator == (const utf8_iterator& x) const { return cur == x.cur; }
+		bool operator != (const utf8_iterator& x) const { return cur != x.cur; }
+	};
+
+	// 按码点遍历的区间，可以用于 for (char32_t c : utf8_code_points(str))
+	class utf8_range
+	{
+	private:
+		string_view sv;
+
+	public:
+		explicit utf8_range(const string_view& s) : sv(s) { }
+		utf8_iterator begin() const { return utf8_iterator(sv.begin()); }
+		utf8_iterator end() const { return utf8_iterator(sv.end()); }
+		size_t size() const { return utf8_length(sv); }
+		bool empty() const { return sv.empty(); }
+	};
+
+	inline utf8_range utf8_code_points(const string_view& sv) { return utf8_range(sv); }
+
+}  // namespace TinySTL
+
+
+#endif // !_UTF8_H_
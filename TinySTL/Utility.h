@@ -28,7 +28,26 @@ namespace TinySTL
 
 		pair() : first(first_type()), second(second_type()) { }
 		pair(const T1& x, const T2& y) : first(x), second(y) { }
+		template<class U1, class U2>
+		pair(const pair<U1, U2>& x) : first(x.first), second(x.second) { }   // 如pair<K, V>转换为pair<const K, V>
 	};
+
+	template<class T1, class T2>
+	inline bool operator == (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+	{
+		return lhs.first == rhs.first && lhs.second == rhs.second;
+	}
+	template<class T1, class T2>
+	inline bool operator != (const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template<class T1, class T2>
+	inline pair<T1, T2> make_pair(const T1& x, const T2& y)
+	{
+		return pair<T1, T2>(x, y);
+	}
 	
 	
 }    // namespace TinySTL
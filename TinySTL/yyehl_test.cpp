@@ -3,6 +3,16 @@
 #include "Test\Vector_Test.h"
 #include "Test\Algorithm_Test.h"
 #include "Test\List_Test.h"
+#include "Test\Charconv_Test.h"
+#include "Test\Flat_hash_map_Test.h"
+#include "Test\Flat_map_Test.h"
+#include "Test\Hash_map_Test.h"
+#include "Test\RB_tree_Test.h"
+#include "Test\Concurrent_skiplist_Test.h"
+#include "Test\Concurrent_hash_map_Test.h"
+#include "Test\Persistent_map_Test.h"
+#include "Test\Hash_index_Test.h"
+#include "Test\Btree_Test.h"
 
 #include <vector>
 #include <iostream>
@@ -14,6 +24,16 @@ int main()
 	//TinySTL::VectorTest::testAllCases();
 	//TinySTL::testAll_algorithm_Cases();
 	TinySTL::ListTest::testAllCases();
+	TinySTL::CharconvTest::testAllCases();
+	TinySTL::Flat_hash_mapTest::testAllCases();
+	TinySTL::Flat_mapTest::testAllCases();
+	TinySTL::Hash_mapTest::testAllCases();
+	TinySTL::RB_treeTest::testAllCases();
+	TinySTL::Concurrent_skiplistTest::testAllCases();
+	TinySTL::Concurrent_hash_mapTest::testAllCases();
+	TinySTL::Persistent_mapTest::testAllCases();
+	TinySTL::Hash_indexTest::testAllCases();
+	TinySTL::BtreeTest::testAllCases();
 
 	
 